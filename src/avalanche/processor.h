@@ -238,6 +238,10 @@ public:
                          std::atomic<bool> &interrupt) override {
         return false;
     }
+    bool ProcessReadOnlyMessages(const ::Config &config, CNode *pnode,
+                                 std::atomic<bool> &interrupt) override {
+        return false;
+    }
     bool SendMessages(const ::Config &config, CNode *pnode) override {
         return false;
     }
@@ -0,0 +1,108 @@
+// Copyright (c) 2022 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <config.h>
+#include <key.h>
+#include <script/interpreter.h>
+#include <script/sighashtype.h>
+#include <script/standard.h>
+#include <test/util/mining.h>
+#include <test/util/setup_common.h>
+#include <txmempool.h>
+#include <validation.h>
+
+#include <vector>
+
+static void MempoolLoad(benchmark::Bench &bench) {
+    const Config &config = GetConfig();
+    TestingSetup test_setup{
+        CBaseChainParams::REGTEST,
+        /* extra_args */
+        {
+            "-nodebuglogfile",
+            "-nodebug",
+        },
+    };
+    ChainstateManager &chainman = *test_setup.m_node.chainman;
+    CTxMemPool &mempool = *test_setup.m_node.mempool;
+
+    const CScript redeemScript = CScript() << OP_DROP << OP_TRUE;
+    const CScript SCRIPT_PUB =
+        CScript() << OP_HASH160 << ToByteVector(CScriptID(redeemScript))
+                  << OP_EQUAL;
+    const CScript scriptSig = CScript() << std::vector<uint8_t>(100, 0xff)
+                                        << ToByteVector(redeemScript);
+
+    // Reload NUM_SPLITS * OUTPUTS_PER_SPLIT signed transactions, each spending
+    // a confirmed output.
+    constexpr size_t NUM_SPLITS{20};
+    constexpr size_t OUTPUTS_PER_SPLIT{1000};
+    constexpr Amount OUTPUT_VALUE{100000 * SATOSHI};
+
+    CKey key;
+    key.MakeNewKey(true);
+    const CScript p2pk = CScript() << ToByteVector(key.GetPubKey())
+                                   << OP_CHECKSIG;
+
+    std::vector<CTxIn> coinbases;
+    for (size_t b = 0; b < COINBASE_MATURITY + NUM_SPLITS; ++b) {
+        CTxIn coinbase = MineBlock(config, test_setup.m_node, SCRIPT_PUB);
+        if (b < NUM_SPLITS) {
+            coinbases.push_back(coinbase);
+        }
+    }
+
+    const auto submit = [&](const CMutableTransaction &tx) {
+        LOCK(::cs_main);
+        const MempoolAcceptResult res =
+            chainman.ProcessTransaction(MakeTransactionRef(tx));
+        assert(res.m_result_type == MempoolAcceptResult::ResultType::VALID);
+    };
+
+    std::vector<CTransactionRef> splits;
+    for (const CTxIn &coinbase : coinbases) {
+        CMutableTransaction split;
+        split.vin.push_back(coinbase);
+        split.vin.back().scriptSig = scriptSig;
+        for (size_t i = 0; i < OUTPUTS_PER_SPLIT; ++i) {
+            split.vout.emplace_back(OUTPUT_VALUE, p2pk);
+        }
+        submit(split);
+        splits.push_back(MakeTransactionRef(split));
+    }
+    while (mempool.size() > 0) {
+        MineBlock(config, test_setup.m_node, SCRIPT_PUB);
+    }
+
+    for (const CTransactionRef &split : splits) {
+        for (size_t i = 0; i < OUTPUTS_PER_SPLIT; ++i) {
+            CMutableTransaction tx;
+            tx.vin.emplace_back(COutPoint(split->GetId(), i));
+            tx.vout.emplace_back(OUTPUT_VALUE - 1000 * SATOSHI, SCRIPT_PUB);
+
+            std::vector<uint8_t> sig;
+            const uint256 hash =
+                SignatureHash(p2pk, CTransaction(tx), 0,
+                              SigHashType().withForkId(), OUTPUT_VALUE);
+            key.SignSchnorr(hash, sig);
+            sig.push_back(uint8_t(SIGHASH_ALL | SIGHASH_FORKID));
+            tx.vin[0].scriptSig << sig;
+            submit(tx);
+        }
+    }
+    assert(mempool.size() == NUM_SPLITS * OUTPUTS_PER_SPLIT);
+    bool dumped = DumpMempool(mempool, chainman.ActiveChainstate());
+    assert(dumped);
+
+    bench.run([&] {
+        mempool.clear();
+        bool loaded =
+            LoadMempool(config, mempool, chainman.ActiveChainstate());
+        assert(loaded);
+        assert(mempool.size() == NUM_SPLITS * OUTPUTS_PER_SPLIT);
+    });
+}
+
+BENCHMARK(MempoolLoad);
@@ -0,0 +1,106 @@
+// Copyright (c) 2022 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <chain.h>
+#include <config.h>
+#include <consensus/validation.h>
+#include <script/standard.h>
+#include <test/util/mining.h>
+#include <test/util/setup_common.h>
+#include <txmempool.h>
+#include <validation.h>
+
+#include <vector>
+
+static void MempoolReorg(benchmark::Bench &bench) {
+    const Config &config = GetConfig();
+    TestingSetup test_setup{
+        CBaseChainParams::REGTEST,
+        /* extra_args */
+        {
+            "-nodebuglogfile",
+            "-nodebug",
+        },
+    };
+    ChainstateManager &chainman = *test_setup.m_node.chainman;
+    CTxMemPool &mempool = *test_setup.m_node.mempool;
+
+    const CScript redeemScript = CScript() << OP_DROP << OP_TRUE;
+    const CScript SCRIPT_PUB =
+        CScript() << OP_HASH160 << ToByteVector(CScriptID(redeemScript))
+                  << OP_EQUAL;
+
+    const CScript scriptSig = CScript() << std::vector<uint8_t>(100, 0xff)
+                                        << ToByteVector(redeemScript);
+
+    // Disconnect and reconnect NUM_BLOCKS blocks of TXS_PER_BLOCK transactions
+    // each, so the transactions are added back to the mempool by
+    // updateMempoolForReorg().
+    constexpr size_t NUM_BLOCKS{10};
+    constexpr size_t TXS_PER_BLOCK{500};
+
+    std::vector<CTxIn> coinbases;
+    for (size_t b = 0; b < COINBASE_MATURITY + NUM_BLOCKS; ++b) {
+        CTxIn coinbase = MineBlock(config, test_setup.m_node, SCRIPT_PUB);
+        if (b < NUM_BLOCKS) {
+            coinbases.push_back(coinbase);
+        }
+    }
+
+    const auto submit = [&](const CMutableTransaction &tx) {
+        LOCK(::cs_main);
+        const MempoolAcceptResult res =
+            chainman.ProcessTransaction(MakeTransactionRef(tx));
+        assert(res.m_result_type == MempoolAcceptResult::ResultType::VALID);
+    };
+
+    // Split the coinbases so each of the reorged blocks can spend
+    // TXS_PER_BLOCK confirmed outputs.
+    std::vector<CTransactionRef> splits;
+    for (const CTxIn &coinbase : coinbases) {
+        CMutableTransaction split;
+        split.vin.push_back(coinbase);
+        split.vin.back().scriptSig = scriptSig;
+        for (size_t i = 0; i < TXS_PER_BLOCK; ++i) {
+            split.vout.emplace_back(100000 * SATOSHI, SCRIPT_PUB);
+        }
+        submit(split);
+        splits.push_back(MakeTransactionRef(split));
+    }
+    MineBlock(config, test_setup.m_node, SCRIPT_PUB);
+
+    CBlockIndex *fork_child = nullptr;
+    for (const CTransactionRef &split : splits) {
+        for (size_t i = 0; i < TXS_PER_BLOCK; ++i) {
+            CMutableTransaction tx;
+            tx.vin.emplace_back(COutPoint(split->GetId(), i), scriptSig);
+            tx.vout.emplace_back(90000 * SATOSHI, SCRIPT_PUB);
+            submit(tx);
+        }
+        MineBlock(config, test_setup.m_node, SCRIPT_PUB);
+        assert(mempool.size() == 0);
+        if (!fork_child) {
+            LOCK(::cs_main);
+            fork_child = chainman.ActiveTip();
+        }
+    }
+
+    bench.run([&] {
+        BlockValidationState state;
+        chainman.ActiveChainstate().InvalidateBlock(config, state, fork_child);
+        assert(state.IsValid());
+        assert(mempool.size() == NUM_BLOCKS * TXS_PER_BLOCK);
+
+        {
+            LOCK(::cs_main);
+            chainman.ActiveChainstate().ResetBlockFailureFlags(fork_child);
+        }
+        chainman.ActiveChainstate().ActivateBestChain(config, state);
+        assert(state.IsValid());
+        assert(mempool.size() == 0);
+    });
+}
+
+BENCHMARK(MempoolReorg);
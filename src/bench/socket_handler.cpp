@@ -0,0 +1,107 @@
+// Copyright (c) 2022 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <addrman.h>
+#include <config.h>
+#include <net.h>
+#include <netmessagemaker.h>
+#include <protocol.h>
+#include <util/system.h>
+#include <version.h>
+
+#include <test/util/net.h>
+#include <test/util/setup_common.h>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+/**
+ * Run the socket handler with many mostly idle connections, a single one of
+ * them receiving a ping per iteration.
+ */
+static void SocketHandlerCommon(benchmark::Bench &bench, bool use_epoll) {
+    const Config &config = GetConfig();
+    BasicTestingSetup test_setup{
+        CBaseChainParams::REGTEST,
+        /* extra_args */
+        {
+            "-nodebuglogfile",
+            "-nodebug",
+        },
+    };
+    AddrMan addrman{/* asmap= */ std::vector<bool>(),
+                    /* consistency_check_ratio= */ 0};
+    ConnmanTestMsg connman{config, 0x1337, 0x1337, addrman};
+    connman.SetPeerConnectTimeout(std::chrono::seconds{99999});
+    if (!use_epoll) {
+        connman.DisableEpoll();
+    }
+
+    // Each connection uses 2 file descriptors.
+    constexpr int MAX_NODES{1000};
+    const int fd_limit = RaiseFileDescriptorLimit(2 * MAX_NODES + 100);
+    const int num_nodes = std::min(MAX_NODES, (fd_limit - 100) / 2);
+    assert(num_nodes > 0);
+
+    std::vector<int> remote_sockets;
+    CNode *active_node = nullptr;
+    for (int i = 0; i < num_nodes; ++i) {
+        int fds[2];
+        int ret = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+        assert(ret == 0);
+        CNode *node = new CNode(
+            i, NODE_NETWORK, fds[0], CAddress(), /* nKeyedNetGroupIn */ 0,
+            /* nLocalHostNonceIn */ 0, /* nLocalExtraEntropyIn */ 0,
+            CAddress(), /* pszDest */ "", ConnectionType::INBOUND,
+            /* inbound_onion */ false);
+        connman.AddTestNode(*node);
+        connman.RegisterTestNodeSocket(*node);
+        remote_sockets.push_back(fds[1]);
+        if (i == num_nodes / 2) {
+            active_node = node;
+        }
+    }
+    // Consume the initial writable events.
+    connman.SocketHandlerOnce();
+
+    CSerializedNetMsg msg =
+        CNetMsgMaker(INIT_PROTO_VERSION).Make(NetMsgType::PING, uint64_t{0});
+    std::vector<uint8_t> bytes;
+    V1TransportSerializer{}.prepareForTransport(config, msg, bytes);
+    bytes.insert(bytes.end(), msg.data.begin(), msg.data.end());
+
+    bench.minEpochIterations(100).run([&] {
+        ssize_t written =
+            write(remote_sockets[num_nodes / 2], bytes.data(), bytes.size());
+        assert(written == ssize_t(bytes.size()));
+        connman.SocketHandlerOnce();
+
+        LOCK(active_node->cs_vProcessMsg);
+        assert(active_node->vProcessMsg.size() == 1);
+        active_node->vProcessMsg.clear();
+        active_node->nProcessQueueSize = 0;
+        active_node->fPauseRecv = false;
+    });
+
+    connman.ClearTestNodes();
+    for (int socket : remote_sockets) {
+        close(socket);
+    }
+}
+
+static void SocketHandlerEpoll(benchmark::Bench &bench) {
+    SocketHandlerCommon(bench, /* use_epoll */ true);
+}
+
+static void SocketHandlerPoll(benchmark::Bench &bench) {
+    SocketHandlerCommon(bench, /* use_epoll */ false);
+}
+
+BENCHMARK(SocketHandlerEpoll);
+BENCHMARK(SocketHandlerPoll);
@@ -97,6 +97,9 @@ typedef char *sockopt_arg_type;
 // https://github.com/bitcoin/bitcoin/pull/14336#issuecomment-437384408
 #if defined(__linux__)
 #define USE_POLL
+// The socket handler registers the sockets once to an edge-triggered epoll
+// instance, falling back to poll if it can't be created.
+#define USE_EPOLL
 #endif
 
 static bool inline IsSelectableSocket(const SOCKET &s) {
@@ -40,6 +40,12 @@ enum class TxValidationResult {
     TX_CONFLICT,
     //! violated mempool's fee/size/descendant/etc limits
     TX_MEMPOOL_POLICY,
+    /**
+     * Didn't meet the minimum relay or mempool minimum fee rate on its own,
+     * but might be accepted as part of a package whose other transactions pay
+     * for it.
+     */
+    TX_PACKAGE_RECONSIDERABLE,
     //! this node does not have a mempool so can't validate the transaction
     TX_NO_MEMPOOL,
 };
@@ -92,6 +92,7 @@
 #include <csignal>
 #include <sys/stat.h>
 #endif
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <functional>
@@ -260,9 +261,9 @@ void Shutdown(NodeContext &node) {
     node.banman.reset();
     node.addrman.reset();
 
-    if (node.mempool && node.mempool->IsLoaded() &&
+    if (node.mempool && node.mempool->IsLoaded() && node.chainman &&
         node.args->GetBoolArg("-persistmempool", DEFAULT_PERSIST_MEMPOOL)) {
-        DumpMempool(*node.mempool);
+        DumpMempool(*node.mempool, node.chainman->ActiveChainstate());
     }
 
     // FlushStateToDisk generates a ChainStateFlushed callback, which we should
@@ -547,6 +548,12 @@ void SetupServerArgs(NodeContext &node) {
                              "memory (default: %u)",
                              DEFAULT_MAX_ORPHAN_TRANSACTIONS),
                    ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-packagerelay",
+                   strprintf("Request and serve packages of unconfirmed "
+                             "transactions, allowing a child to pay for its "
+                             "low fee parents (default: %d)",
+                             DEFAULT_PACKAGE_RELAY),
+                   ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-mempoolexpiry=<n>",
                    strprintf("Do not keep transactions in the mempool longer "
                              "than <n> hours (default: %u)",
@@ -748,6 +755,14 @@ void SetupServerArgs(NodeContext &node) {
                   "backward by this amount. (default: %u seconds)",
                   DEFAULT_MAX_TIME_ADJUSTMENT),
         ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
+    argsman.AddArg(
+        "-msgworkers=<n>",
+        strprintf("Number of threads serving the read-only peer requests "
+                  "(getdata, getheaders and ping) concurrently with the "
+                  "processing of the other messages, up to %d. If 0, they are "
+                  "served by the message handler thread (default: %d)",
+                  MAX_MSG_WORKERS, DEFAULT_MSG_WORKERS),
+        ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-onion=<ip:port>",
                    strprintf("Use separate SOCKS5 proxy to reach peers via Tor "
                              "onion services (default: %s)",
@@ -2941,6 +2956,9 @@ bool AppInitMain(Config &config, RPCServer &rpcServer,
         1024 * 1024 *
         args.GetIntArg("-maxuploadtarget", DEFAULT_MAX_UPLOAD_TARGET);
     connOptions.m_peer_connect_timeout = peer_connect_timeout;
+    connOptions.m_msg_workers = std::clamp<int64_t>(
+        args.GetIntArg("-msgworkers", DEFAULT_MSG_WORKERS), 0,
+        MAX_MSG_WORKERS);
 
     const auto BadPortWarning = [](const char *prefix, uint16_t port) {
         return strprintf(_("%s request to listen on port %u. This port is "
@@ -42,6 +42,10 @@
 #include <poll.h>
 #endif
 
+#ifdef USE_EPOLL
+#include <sys/epoll.h>
+#endif
+
 #include <algorithm>
 #include <array>
 #include <cmath>
@@ -105,6 +109,8 @@ enum BindFlags {
 // The set of sockets cannot be modified while waiting
 // The sleep time needs to be small to avoid new sockets stalling
 static const uint64_t SELECT_TIMEOUT_MILLISECONDS = 50;
+/** Maximum number of socket events returned by a single epoll wait. */
+static constexpr size_t MAX_EPOLL_EVENTS = 1024;
 
 const std::string NET_MESSAGE_COMMAND_OTHER = "*other*";
 
@@ -1406,6 +1412,7 @@ void CConnman::CreateNodeFromAcceptedSocket(SOCKET hSocket,
 
     LogPrint(BCLog::NET, "connection from %s accepted\n", addr.ToString());
 
+    RegisterSocketEvents(hSocket, pnode);
     {
         LOCK(cs_vNodes);
         vNodes.push_back(pnode);
@@ -1769,9 +1776,74 @@ void CConnman::SocketEvents(std::set<SOCKET> &recv_set,
 }
 #endif
 
+void CConnman::RegisterSocketEvents(SOCKET socket, CNode *node) {
+#ifdef USE_EPOLL
+    if (m_epoll_fd == -1 || socket == INVALID_SOCKET) {
+        return;
+    }
+
+    // The node sockets are edge-triggered so they are only reported when
+    // their state changes, and the readiness is kept in the node until the
+    // socket is drained. Listening sockets are level-triggered and have no
+    // node attached.
+    struct epoll_event event {};
+    event.events = node ? EPOLLIN | EPOLLOUT | EPOLLET : EPOLLIN;
+    event.data.ptr = node;
+    if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, socket, &event) != 0) {
+        LogPrintf("Failed to register socket to epoll: %s\n",
+                  NetworkErrorString(WSAGetLastError()));
+        // The node would never be serviced.
+        if (node) {
+            node->fDisconnect = true;
+        }
+    }
+#endif
+}
+
+void CConnman::EpollSocketEvents(std::set<SOCKET> &recv_set) {
+#ifdef USE_EPOLL
+    std::array<struct epoll_event, MAX_EPOLL_EVENTS> events;
+    const int num_events =
+        epoll_wait(m_epoll_fd, events.data(), events.size(),
+                   m_epoll_pending ? 0 : SELECT_TIMEOUT_MILLISECONDS);
+
+    if (interruptNet) {
+        return;
+    }
+
+    // The nodes can't be deleted while they are registered: their socket is
+    // closed before they are deleted by this thread, which unregisters it.
+    for (int i = 0; i < num_events; ++i) {
+        CNode *pnode = static_cast<CNode *>(events[i].data.ptr);
+        if (!pnode) {
+            // The listening sockets are non-blocking, so the ones that are not
+            // ready will just fail to accept.
+            for (const ListenSocket &hListenSocket : vhListenSocket) {
+                recv_set.insert(hListenSocket.socket);
+            }
+            continue;
+        }
+        if (events[i].events & EPOLLIN) {
+            pnode->m_sock_recv_ready = true;
+        }
+        if (events[i].events & EPOLLOUT) {
+            pnode->m_sock_send_ready = true;
+        }
+        if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+            pnode->m_sock_error = true;
+        }
+    }
+#endif
+}
+
 void CConnman::SocketHandler() {
     std::set<SOCKET> recv_set, send_set, error_set;
-    SocketEvents(recv_set, send_set, error_set);
+    const bool use_epoll = m_epoll_fd != -1;
+    if (use_epoll) {
+        EpollSocketEvents(recv_set);
+    } else {
+        SocketEvents(recv_set, send_set, error_set);
+    }
 
     if (interruptNet) {
         return;
@@ -1798,6 +1870,7 @@ void CConnman::SocketHandler() {
             pnode->AddRef();
         }
     }
+    m_epoll_pending = false;
     for (CNode *pnode : vNodesCopy) {
         if (interruptNet) {
             return;
@@ -1809,7 +1882,24 @@ void CConnman::SocketHandler() {
         bool recvSet = false;
         bool sendSet = false;
         bool errorSet = false;
-        {
+        if (use_epoll) {
+            // Same logic as GenerateSelectSet, applied to the readiness
+            // reported by epoll.
+            bool select_send;
+            {
+                LOCK(pnode->cs_vSend);
+                select_send = !pnode->vSendMsg.empty();
+            }
+
+            LOCK(pnode->cs_hSocket);
+            if (pnode->hSocket == INVALID_SOCKET) {
+                continue;
+            }
+            recvSet = !select_send && !pnode->fPauseRecv &&
+                      pnode->m_sock_recv_ready;
+            sendSet = select_send && pnode->m_sock_send_ready;
+            errorSet = pnode->m_sock_error;
+        } else {
             LOCK(pnode->cs_hSocket);
             if (pnode->hSocket == INVALID_SOCKET) {
                 continue;
@@ -1830,6 +1920,13 @@ void CConnman::SocketHandler() {
                 nBytes = recv(pnode->hSocket, (char *)pchBuf, sizeof(pchBuf),
                               MSG_DONTWAIT);
             }
+            if (use_epoll) {
+                // A short read drained the socket, and epoll will report when
+                // more data arrives. Otherwise there may be more to read.
+                pnode->m_sock_recv_ready = nBytes == sizeof(pchBuf);
+                pnode->m_sock_error = false;
+                m_epoll_pending |= pnode->m_sock_recv_ready;
+            }
             if (nBytes > 0) {
                 bool notify = false;
                 if (!pnode->ReceiveMsgBytes(
@@ -1888,6 +1985,11 @@ void CConnman::SocketHandler() {
             if (nBytes) {
                 RecordBytesSent(nBytes);
             }
+            if (use_epoll) {
+                // Data is left to send only if the socket would block, and
+                // epoll will report when it is writable again.
+                pnode->m_sock_send_ready = pnode->vSendMsg.empty();
+            }
         }
 
         if (InactivityCheck(*pnode)) {
@@ -1916,6 +2018,18 @@ void CConnman::WakeMessageHandler() {
         fMsgProcWake = true;
     }
     condMsgProc.notify_one();
+    WakeMessageWorkers();
+}
+
+void CConnman::WakeMessageWorkers() {
+    if (m_msg_workers == 0) {
+        return;
+    }
+    {
+        LOCK(mutexMsgProc);
+        ++m_msg_worker_wake_seq;
+    }
+    m_cond_msg_worker.notify_all();
 }
 
 void CConnman::ThreadDNSAddressSeed() {
@@ -2614,6 +2728,8 @@ void CConnman::OpenNetworkConnection(const CAddress &addrConnect,
         interface->InitializeNode(*config, pnode);
     }
 
+    RegisterSocketEvents(WITH_LOCK(pnode->cs_hSocket, return pnode->hSocket),
+                         pnode);
     {
         LOCK(cs_vNodes);
         vNodes.push_back(pnode);
@@ -2638,27 +2754,40 @@ void CConnman::ThreadMessageHandler() {
                 continue;
             }
 
-            bool fMoreNodeWork = false;
-            // Receive messages
-            for (auto interface : m_msgproc) {
-                fMoreNodeWork |= interface->ProcessMessages(
-                    *config, pnode, flagInterruptMsgProc);
-            }
-            fMoreWork |= (fMoreNodeWork && !pnode->fPauseSend);
-            if (flagInterruptMsgProc) {
-                return;
-            }
-
-            // Send messages
             {
-                LOCK(pnode->cs_sendProcessing);
+                // A message worker is serving this node. It will hand it back
+                // if there is more to process here.
+                TRY_LOCK(pnode->m_msg_process_mutex, lockMsgProcess);
+                if (!lockMsgProcess) {
+                    continue;
+                }
+
+                bool fMoreNodeWork = false;
+                // Receive messages
                 for (auto interface : m_msgproc) {
-                    interface->SendMessages(*config, pnode);
+                    fMoreNodeWork |= interface->ProcessMessages(
+                        *config, pnode, flagInterruptMsgProc);
+                }
+                fMoreWork |= (fMoreNodeWork && !pnode->fPauseSend);
+                if (flagInterruptMsgProc) {
+                    return;
+                }
+
+                // Send messages
+                {
+                    LOCK(pnode->cs_sendProcessing);
+                    for (auto interface : m_msgproc) {
+                        interface->SendMessages(*config, pnode);
+                    }
+                }
+
+                if (flagInterruptMsgProc) {
+                    return;
                 }
             }
 
-            if (flagInterruptMsgProc) {
-                return;
+            if (pnode->m_msg_process_handoff.exchange(false)) {
+                WakeMessageWorkers();
             }
         }
 
@@ -2681,6 +2810,72 @@ void CConnman::ThreadMessageHandler() {
     }
 }
 
+void CConnman::ThreadMessageWorker() {
+    while (!flagInterruptMsgProc) {
+        const uint64_t wake_seq =
+            WITH_LOCK(mutexMsgProc, return m_msg_worker_wake_seq);
+
+        std::vector<CNode *> vNodesCopy;
+        {
+            LOCK(cs_vNodes);
+            vNodesCopy = vNodes;
+            for (CNode *pnode : vNodesCopy) {
+                pnode->AddRef();
+            }
+        }
+
+        bool fMoreWork = false;
+
+        for (CNode *pnode : vNodesCopy) {
+            if (pnode->fDisconnect) {
+                continue;
+            }
+
+            {
+                // The node is being processed by another thread, which will
+                // hand it over if needed.
+                TRY_LOCK(pnode->m_msg_process_mutex, lockMsgProcess);
+                if (!lockMsgProcess) {
+                    continue;
+                }
+
+                bool fMoreNodeWork = false;
+                for (auto interface : m_msgproc) {
+                    fMoreNodeWork |= interface->ProcessReadOnlyMessages(
+                        *config, pnode, flagInterruptMsgProc);
+                }
+                fMoreWork |= (fMoreNodeWork && !pnode->fPauseSend);
+                if (flagInterruptMsgProc) {
+                    return;
+                }
+            }
+
+            if (pnode->m_msg_process_handoff.exchange(false)) {
+                WITH_LOCK(mutexMsgProc, fMsgProcWake = true);
+                condMsgProc.notify_one();
+            }
+        }
+
+        {
+            LOCK(cs_vNodes);
+            for (CNode *pnode : vNodesCopy) {
+                pnode->Release();
+            }
+        }
+
+        WAIT_LOCK(mutexMsgProc, lock);
+        if (!fMoreWork) {
+            m_cond_msg_worker.wait_until(
+                lock,
+                std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(100),
+                [&]() EXCLUSIVE_LOCKS_REQUIRED(mutexMsgProc) {
+                    return m_msg_worker_wake_seq != wake_seq;
+                });
+        }
+    }
+}
+
 void CConnman::ThreadI2PAcceptIncoming() {
     static constexpr auto err_wait_begin = 1s;
     static constexpr auto err_wait_cap = 5min;
@@ -2791,6 +2986,7 @@ bool CConnman::BindListenPort(const CService &addrBind, bilingual_str &strError,
     }
 
     vhListenSocket.push_back(ListenSocket(sock->Release(), permissions));
+    RegisterSocketEvents(vhListenSocket.back().socket, nullptr);
     return true;
 }
 
@@ -2862,6 +3058,13 @@ CConnman::CConnman(const Config &configIn, uint64_t nSeed0In, uint64_t nSeed1In,
                    AddrMan &addrmanIn, bool network_active)
     : config(&configIn), addrman(addrmanIn), nSeed0(nSeed0In),
       nSeed1(nSeed1In) {
+#ifdef USE_EPOLL
+    m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epoll_fd == -1) {
+        LogPrintf("Failed to create an epoll instance, using poll: %s\n",
+                  NetworkErrorString(WSAGetLastError()));
+    }
+#endif
     SetTryNewOutboundPeer(false);
 
     Options connOptions;
@@ -3023,6 +3226,12 @@ bool CConnman::Start(CScheduler &scheduler, const Options &connOptions) {
     // Process messages
     threadMessageHandler = std::thread(&util::TraceThread, "msghand",
                                        [this] { ThreadMessageHandler(); });
+    for (int i = 0; i < m_msg_workers; ++i) {
+        m_msg_worker_threads.emplace_back([this, i] {
+            util::TraceThread(strprintf("msgworker.%i", i).c_str(),
+                              [this] { ThreadMessageWorker(); });
+        });
+    }
 
     if (connOptions.m_i2p_accept_incoming &&
         m_i2p_sam_session.get() != nullptr) {
@@ -3061,6 +3270,7 @@ void CConnman::Interrupt() {
         flagInterruptMsgProc = true;
     }
     condMsgProc.notify_all();
+    m_cond_msg_worker.notify_all();
 
     interruptNet();
     InterruptSocks5(true);
@@ -3085,6 +3295,12 @@ void CConnman::StopThreads() {
     if (threadMessageHandler.joinable()) {
         threadMessageHandler.join();
     }
+    for (std::thread &thread : m_msg_worker_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    m_msg_worker_threads.clear();
     if (threadOpenConnections.joinable()) {
         threadOpenConnections.join();
     }
@@ -3155,6 +3371,11 @@ void CConnman::DeleteNode(CNode *pnode) {
 CConnman::~CConnman() {
     Interrupt();
     Stop();
+#ifdef USE_EPOLL
+    if (m_epoll_fd != -1) {
+        close(m_epoll_fd);
+    }
+#endif
 }
 
 std::vector<CAddress> CConnman::GetAddresses(size_t max_addresses,
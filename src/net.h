@@ -97,6 +97,10 @@ static const bool DEFAULT_BLOCKSONLY = false;
 static const int64_t DEFAULT_PEER_CONNECT_TIMEOUT = 60;
 /** Number of file descriptors required for message capture **/
 static const int NUM_FDS_MESSAGE_CAPTURE = 1;
+/** -msgworkers default: read-only requests are served by msghand */
+static const int DEFAULT_MSG_WORKERS = 0;
+/** Maximum number of message worker threads */
+static const int MAX_MSG_WORKERS = 16;
 
 static const bool DEFAULT_FORCEDNSSEED = false;
 static const bool DEFAULT_DNSSEED = true;
@@ -478,6 +482,17 @@ public:
     size_t nProcessQueueSize{0};
 
     RecursiveMutex cs_sendProcessing;
+    /**
+     * Held by the thread processing the messages of this node, so they are
+     * processed in order by a single thread at a time.
+     */
+    Mutex m_msg_process_mutex;
+    /**
+     * Set when the next message of this node is to be processed by the other
+     * kind of message processing thread (the message handler or a message
+     * worker), which is woken up once the node is released.
+     */
+    std::atomic_bool m_msg_process_handoff{false};
 
     uint64_t nRecvBytes GUARDED_BY(cs_vRecv){0};
 
@@ -526,6 +541,14 @@ public:
     const uint64_t nKeyedNetGroup;
     std::atomic_bool fPauseRecv{false};
     std::atomic_bool fPauseSend{false};
+    /**
+     * Readiness of hSocket as reported by the edge-triggered epoll events. It
+     * is kept until the socket is drained, as no new event is reported before
+     * that. Only used by the socket handler thread.
+     */
+    bool m_sock_recv_ready{false};
+    bool m_sock_send_ready{false};
+    bool m_sock_error{false};
 
     bool IsOutboundOrBlockRelayConn() const {
         switch (m_conn_type) {
@@ -902,6 +925,21 @@ public:
     virtual bool ProcessMessages(const Config &config, CNode *pnode,
                                  std::atomic<bool> &interrupt) = 0;
 
+    /**
+     * Serve the read-only requests received from a given node: the queued
+     * data requests, and the messages at the front of its queue that don't
+     * alter the shared state. This runs on the message worker threads,
+     * concurrently with the processing of the other nodes.
+     *
+     * @param[in]   config          The applicable configuration object.
+     * @param[in]   pnode           The node which we have received messages
+     * from.
+     * @param[in]   interrupt       Interrupt condition for processing threads
+     * @return                      True if there is more work to be done
+     */
+    virtual bool ProcessReadOnlyMessages(const Config &config, CNode *pnode,
+                                         std::atomic<bool> &interrupt) = 0;
+
     /**
      * Send queued protocol messages to a given node.
      *
@@ -950,6 +988,7 @@ public:
         unsigned int nReceiveFloodSize = 0;
         uint64_t nMaxOutboundLimit = 0;
         int64_t m_peer_connect_timeout = DEFAULT_PEER_CONNECT_TIMEOUT;
+        int m_msg_workers = DEFAULT_MSG_WORKERS;
         std::vector<std::string> vSeedNodes;
         std::vector<NetWhitelistPermissions> vWhitelistedRange;
         std::vector<NetWhitebindPermissions> vWhiteBinds;
@@ -990,6 +1029,7 @@ public:
         nReceiveFloodSize = connOptions.nReceiveFloodSize;
         m_peer_connect_timeout =
             std::chrono::seconds{connOptions.m_peer_connect_timeout};
+        m_msg_workers = connOptions.m_msg_workers;
         {
             LOCK(cs_totalBytesSent);
             nMaxOutboundLimit = connOptions.nMaxOutboundLimit;
@@ -1149,6 +1189,13 @@ public:
     unsigned int GetReceiveFloodSize() const;
 
     void WakeMessageHandler();
+    void WakeMessageWorkers();
+
+    /**
+     * Number of message worker threads. If non zero, the read-only requests
+     * are served by the workers rather than the message handler thread.
+     */
+    int GetMessageWorkers() const { return m_msg_workers; }
 
     /**
      * Attempts to obfuscate tx time through exponentially distributed emitting.
@@ -1194,6 +1241,7 @@ private:
                           std::function<void(const CAddress &, ConnectionType)>
                               mockOpenConnection);
     void ThreadMessageHandler();
+    void ThreadMessageWorker();
     void ThreadI2PAcceptIncoming();
     void AcceptConnection(const ListenSocket &hListenSocket);
 
@@ -1219,6 +1267,19 @@ private:
                            std::set<SOCKET> &error_set);
     void SocketEvents(std::set<SOCKET> &recv_set, std::set<SOCKET> &send_set,
                       std::set<SOCKET> &error_set);
+    /**
+     * Register the socket of a new node, or a listening socket if node is
+     * null, to the epoll instance. The registration lasts until the socket is
+     * closed.
+     */
+    void RegisterSocketEvents(SOCKET socket, CNode *node);
+    /**
+     * Wait for the epoll events and record them in the node readiness flags.
+     * Only the sockets that changed state since the last call are reported,
+     * rather than polling all of them. The ready listening sockets are
+     * added to recv_set.
+     */
+    void EpollSocketEvents(std::set<SOCKET> &recv_set);
     void SocketHandler();
     void ThreadSocketHandler();
     void ThreadDNSAddressSeed();
@@ -1287,6 +1348,17 @@ private:
     unsigned int nReceiveFloodSize{0};
 
     std::vector<ListenSocket> vhListenSocket;
+    /**
+     * The epoll instance the sockets are registered to, or -1 if the socket
+     * handler waits on the sockets with poll or select.
+     */
+    int m_epoll_fd{-1};
+    /**
+     * Whether a node was left with readiness to service after the last socket
+     * handler loop, so the next epoll wait should not block. Used only by
+     * SocketHandler thread.
+     */
+    bool m_epoll_pending{false};
     std::atomic<bool> fNetworkActive{true};
     bool fAddressesInitialized{false};
     AddrMan &addrman;
@@ -1384,6 +1456,14 @@ private:
     Mutex mutexMsgProc;
     std::atomic<bool> flagInterruptMsgProc{false};
 
+    int m_msg_workers{DEFAULT_MSG_WORKERS};
+    /**
+     * Incremented when new messages are received, so the idle message workers
+     * don't miss a wake up.
+     */
+    uint64_t m_msg_worker_wake_seq GUARDED_BY(mutexMsgProc){0};
+    std::condition_variable m_cond_msg_worker;
+
     /**
      * This is signaled when network activity should cease.
      * A pointer to it is saved in `m_i2p_sam_session`, so make sure that
@@ -1403,6 +1483,7 @@ private:
     std::thread threadOpenAddedConnections;
     std::thread threadOpenConnections;
     std::thread threadMessageHandler;
+    std::vector<std::thread> m_msg_worker_threads;
     std::thread threadI2PAcceptIncoming;
 
     /**
@@ -29,6 +29,7 @@
 #include <netmessagemaker.h>
 #include <node/blockstorage.h>
 #include <policy/fees.h>
+#include <policy/packages.h>
 #include <policy/policy.h>
 #include <primitives/block.h>
 #include <primitives/transaction.h>
@@ -300,6 +301,17 @@ static constexpr double MAX_ADDR_RATE_PER_SECOND{0.1};
  * MAX_ADDR_TO_SEND increment following GETADDR is exempt from this limit).
  */
 static constexpr size_t MAX_ADDR_PROCESSING_TOKEN_BUCKET{MAX_ADDR_TO_SEND};
+/**
+ * Maximum number of getpkgtxns requests that can be in flight to a single
+ * peer. Further orphans from this peer are handled by the regular parent
+ * fetching logic until some requests complete.
+ */
+static constexpr size_t MAX_PEER_PACKAGE_REQUESTS{100};
+/**
+ * How long to wait for a peer to respond to a getpkgtxns request before the
+ * request is forgotten.
+ */
+static constexpr std::chrono::minutes PACKAGE_REQUEST_TIMEOUT{1};
 
 inline size_t GetMaxAddrToSend() {
     return gArgs.GetIntArg("-maxaddrtosend", MAX_ADDR_TO_SEND);
@@ -452,6 +464,16 @@ struct Peer {
      */
     std::set<TxId> m_orphan_work_set GUARDED_BY(g_cs_orphans);
 
+    /** Whether the peer has signaled support for package relay. */
+    std::atomic_bool m_wants_packages{false};
+    /**
+     * Txids of the orphan transactions for which we sent a getpkgtxns request
+     * to this peer and are still awaiting a response, along with the time at
+     * which the request expires.
+     */
+    std::map<TxId, std::chrono::microseconds>
+        m_package_requests GUARDED_BY(g_cs_orphans);
+
     /** Protects m_getdata_requests **/
     Mutex m_getdata_requests_mutex;
     /** Work queue of items requested by this peer **/
@@ -487,6 +509,8 @@ public:
     void FinalizeNode(const Config &config, const CNode &node) override;
     bool ProcessMessages(const Config &config, CNode *pfrom,
                          std::atomic<bool> &interrupt) override;
+    bool ProcessReadOnlyMessages(const Config &config, CNode *pfrom,
+                                 std::atomic<bool> &interrupt) override;
     bool SendMessages(const Config &config, CNode *pto) override
         EXCLUSIVE_LOCKS_REQUIRED(pto->cs_sendProcessing);
 
@@ -507,6 +531,26 @@ public:
                         const std::atomic<bool> &interruptMsgProc) override;
 
 private:
+    /**
+     * Whether a message can be processed by the message worker threads:
+     * it only reads the shared state, or alters state protected by its own
+     * locks, so it can be processed concurrently with the messages of other
+     * peers.
+     */
+    static bool IsReadOnlyMessage(const CNode &pfrom, const CNetMessage &msg);
+
+    /**
+     * Process the next message received from a peer. If the message
+     * workers are enabled, only a read-only message is processed when
+     * read_only is set, and only another message otherwise. When the next
+     * message is for the other kind of thread, the node is handed off.
+     *
+     * @return True if there is more work to be done
+     */
+    bool ProcessNextMessage(const Config &config, CNode *pfrom, Peer &peer,
+                            std::atomic<bool> &interruptMsgProc,
+                            bool read_only);
+
     /**
      * Consider evicting an outbound peer based on the amount of time they've
      * been behind our tip.
@@ -593,6 +637,41 @@ private:
 
     void ProcessOrphanTx(const Config &config, std::set<TxId> &orphan_work_set)
         EXCLUSIVE_LOCKS_REQUIRED(cs_main, g_cs_orphans);
+
+    /**
+     * Add a transaction to the orphanage and limit its size.
+     * @return true if the transaction was added.
+     */
+    bool AddOrphanTx(const CTransactionRef &ptx, NodeId nodeid)
+        EXCLUSIVE_LOCKS_REQUIRED(g_cs_orphans);
+    /**
+     * Whether we can ask this peer for the package of an orphan transaction.
+     * Forgets about the expired requests, and the ones for transactions that
+     * left the orphanage.
+     */
+    bool CanRequestPackage(Peer &peer) EXCLUSIVE_LOCKS_REQUIRED(g_cs_orphans);
+    /**
+     * Ask a peer supporting package relay for the package made of an orphan
+     * transaction and its unconfirmed parents.
+     */
+    void RequestPackage(CNode &pfrom, Peer &peer, const TxId &txid)
+        EXCLUSIVE_LOCKS_REQUIRED(g_cs_orphans);
+    /**
+     * Request the packages of the orphans announced by this peer that spend
+     * a transaction which was rejected because its fee is too low.
+     */
+    void RequestPackagesForOrphanChildren(CNode &pfrom, Peer &peer,
+                                          const CTransaction &tx)
+        EXCLUSIVE_LOCKS_REQUIRED(cs_main, g_cs_orphans);
+    /** Serve a getpkgtxns request from our mempool. */
+    void ProcessGetPackageTxns(CNode &pfrom, const TxId &txid);
+    /**
+     * Validate a package received in response to a getpkgtxns request,
+     * evaluating the fees of the package as a whole.
+     */
+    void ProcessPackageTxns(const Config &config, CNode &pfrom, Peer &peer,
+                            const Package &package)
+        EXCLUSIVE_LOCKS_REQUIRED(cs_main, g_cs_orphans);
     /** Process a single headers message from a peer. */
     void ProcessHeadersMessage(const Config &config, CNode &pfrom,
                                const Peer &peer,
@@ -677,6 +756,9 @@ private:
     /** Whether this node is running in blocks only mode */
     const bool m_ignore_incoming_txs;
 
+    /** Whether package relay is enabled (-packagerelay) */
+    const bool m_package_relay;
+
     /**
      * Whether we've completed initial sync yet, for determining when to turn
      * on extra block-relay-only peers.
@@ -734,6 +816,21 @@ private:
      */
     std::unique_ptr<CRollingBloomFilter> recentRejects GUARDED_BY(cs_main);
     uint256 hashRecentRejectsChainTip GUARDED_BY(cs_main);
+    /**
+     * Filter for the transactions in recentRejects that were rejected only
+     * because their fee rate was too low (TX_PACKAGE_RECONSIDERABLE). These
+     * might still be accepted as part of a package, so an orphan spending
+     * them can be requested along with its parents from peers supporting
+     * package relay. Reset along with recentRejects.
+     *
+     * Memory used: 1.3 MB
+     */
+    std::unique_ptr<CRollingBloomFilter>
+        m_recent_rejects_reconsiderable GUARDED_BY(cs_main);
+
+    /** Record a transaction rejected by the mempool into the rejects filters. */
+    void AddToRecentRejects(const TxId &txid, const TxValidationState &state)
+        EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     /**
      * Filter for transactions that have been recently confirmed.
@@ -2034,6 +2131,7 @@ bool PeerManagerImpl::MaybePunishNodeForTx(NodeId nodeid,
         case TxValidationResult::TX_PREMATURE_SPEND:
         case TxValidationResult::TX_CONFLICT:
         case TxValidationResult::TX_MEMPOOL_POLICY:
+        case TxValidationResult::TX_PACKAGE_RECONSIDERABLE:
         case TxValidationResult::TX_NO_MEMPOOL:
             break;
     }
@@ -2073,9 +2171,14 @@ PeerManagerImpl::PeerManagerImpl(const CChainParams &chainparams,
                                  CTxMemPool &pool, bool ignore_incoming_txs)
     : m_chainparams(chainparams), m_connman(connman), m_addrman(addrman),
       m_banman(banman), m_chainman(chainman), m_mempool(pool),
-      m_stale_tip_check_time(0), m_ignore_incoming_txs(ignore_incoming_txs) {
+      m_stale_tip_check_time(0), m_ignore_incoming_txs(ignore_incoming_txs),
+      m_package_relay(
+          !ignore_incoming_txs &&
+          gArgs.GetBoolArg("-packagerelay", DEFAULT_PACKAGE_RELAY)) {
     // Initialize global variables that cannot be constructed at startup.
     recentRejects.reset(new CRollingBloomFilter(120000, 0.000001));
+    m_recent_rejects_reconsiderable.reset(
+        new CRollingBloomFilter(120000, 0.000001));
 
     {
         LOCK(cs_invalidProofs);
@@ -2326,6 +2429,7 @@ bool PeerManagerImpl::AlreadyHaveTx(const TxId &txid) {
         hashRecentRejectsChainTip =
             m_chainman.ActiveChain().Tip()->GetBlockHash();
         recentRejects->reset();
+        m_recent_rejects_reconsiderable->reset();
     }
 
     if (m_orphanage.HaveTx(txid)) {
@@ -2342,6 +2446,15 @@ bool PeerManagerImpl::AlreadyHaveTx(const TxId &txid) {
     return recentRejects->contains(txid) || m_mempool.exists(txid);
 }
 
+void PeerManagerImpl::AddToRecentRejects(const TxId &txid,
+                                         const TxValidationState &state) {
+    assert(recentRejects);
+    recentRejects->insert(txid);
+    if (state.GetResult() == TxValidationResult::TX_PACKAGE_RECONSIDERABLE) {
+        m_recent_rejects_reconsiderable->insert(txid);
+    }
+}
+
 bool PeerManagerImpl::AlreadyHaveBlock(const BlockHash &block_hash) {
     return m_chainman.m_blockman.LookupBlockIndex(block_hash) != nullptr;
 }
@@ -3125,8 +3238,7 @@ void PeerManagerImpl::ProcessOrphanTx(const Config &config,
             LogPrint(BCLog::MEMPOOL, "   removed orphan tx %s\n",
                      orphanTxId.ToString());
 
-            assert(recentRejects);
-            recentRejects->insert(orphanTxId);
+            AddToRecentRejects(orphanTxId, state);
 
             m_orphanage.EraseTx(orphanTxId);
             break;
@@ -3134,6 +3246,212 @@ void PeerManagerImpl::ProcessOrphanTx(const Config &config,
     }
 }
 
+bool PeerManagerImpl::AddOrphanTx(const CTransactionRef &ptx,
+                                  NodeId nodeid) {
+    AssertLockHeld(g_cs_orphans);
+    if (!m_orphanage.AddTx(ptx, nodeid)) {
+        return false;
+    }
+    AddToCompactExtraTransactions(ptx);
+
+    // DoS prevention: do not allow m_orphanage to grow unbounded (see
+    // CVE-2012-3789)
+    unsigned int nMaxOrphanTx = (unsigned int)std::max(
+        int64_t(0),
+        gArgs.GetIntArg("-maxorphantx", DEFAULT_MAX_ORPHAN_TRANSACTIONS));
+    unsigned int nEvicted = m_orphanage.LimitOrphans(nMaxOrphanTx);
+    if (nEvicted > 0) {
+        LogPrint(BCLog::MEMPOOL, "orphanage overflow, removed %u tx\n",
+                 nEvicted);
+    }
+    return true;
+}
+
+bool PeerManagerImpl::CanRequestPackage(Peer &peer) {
+    AssertLockHeld(g_cs_orphans);
+    if (!m_package_relay || !peer.m_wants_packages) {
+        return false;
+    }
+
+    const auto now = GetTime<std::chrono::microseconds>();
+    for (auto it = peer.m_package_requests.begin();
+         it != peer.m_package_requests.end();) {
+        if (it->second <= now || !m_orphanage.HaveTx(it->first)) {
+            it = peer.m_package_requests.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    return peer.m_package_requests.size() < MAX_PEER_PACKAGE_REQUESTS;
+}
+
+void PeerManagerImpl::RequestPackage(CNode &pfrom, Peer &peer,
+                                     const TxId &txid) {
+    AssertLockHeld(g_cs_orphans);
+    const auto expiry =
+        GetTime<std::chrono::microseconds>() + PACKAGE_REQUEST_TIMEOUT;
+    if (!peer.m_package_requests.emplace(txid, expiry).second) {
+        // Already requested
+        return;
+    }
+
+    LogPrint(BCLog::NET, "Requesting package for tx %s from peer=%d\n",
+             txid.ToString(), pfrom.GetId());
+    const CNetMsgMaker msgMaker(pfrom.GetCommonVersion());
+    m_connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::GETPKGTXNS, txid));
+}
+
+void PeerManagerImpl::RequestPackagesForOrphanChildren(CNode &pfrom,
+                                                       Peer &peer,
+                                                       const CTransaction &tx) {
+    AssertLockHeld(cs_main);
+    AssertLockHeld(g_cs_orphans);
+
+    std::set<TxId> children;
+    m_orphanage.AddChildrenToWorkSet(tx, children);
+    for (const TxId &child_txid : children) {
+        // Only ask the peer which announced the orphan, it is the one that
+        // is the most likely to have the package.
+        if (m_orphanage.GetTx(child_txid).second != pfrom.GetId() ||
+            !CanRequestPackage(peer)) {
+            continue;
+        }
+        RequestPackage(pfrom, peer, child_txid);
+    }
+}
+
+void PeerManagerImpl::ProcessGetPackageTxns(CNode &pfrom, const TxId &txid) {
+    const CNetMsgMaker msgMaker(pfrom.GetCommonVersion());
+    const auto now = GetTime<std::chrono::seconds>();
+    const std::chrono::seconds mempool_req =
+        pfrom.m_tx_relay->m_last_mempool_req.load();
+
+    // Only serve the package if the peer would be allowed to get the child
+    // transaction with a getdata, so this can't be used to probe our mempool.
+    CTransactionRef child = FindTxForGetData(pfrom, txid, mempool_req, now);
+
+    Package package;
+    if (child) {
+        LOCK(m_mempool.cs);
+        auto txiter = m_mempool.GetIter(txid);
+        if (txiter) {
+            const CTxMemPoolEntry::Parents &parents =
+                (*txiter)->GetMemPoolParentsConst();
+            if (parents.size() < MAX_PACKAGE_COUNT) {
+                std::vector<const CTxMemPoolEntry *> sorted_parents;
+                sorted_parents.reserve(parents.size());
+                for (const CTxMemPoolEntry &parent : parents) {
+                    sorted_parents.push_back(&parent);
+                }
+                // A transaction always has less in-mempool ancestors than
+                // its descendants, so this is a topological order.
+                std::sort(sorted_parents.begin(), sorted_parents.end(),
+                          [](const CTxMemPoolEntry *a,
+                             const CTxMemPoolEntry *b) {
+                              return a->GetCountWithAncestors() <
+                                     b->GetCountWithAncestors();
+                          });
+                package.reserve(sorted_parents.size() + 1);
+                for (const CTxMemPoolEntry *parent : sorted_parents) {
+                    package.push_back(parent->GetSharedTx());
+                }
+                package.push_back(child);
+            }
+        }
+    }
+
+    if (package.empty()) {
+        LogPrint(BCLog::NET, "Cannot serve package for tx %s to peer=%d\n",
+                 txid.ToString(), pfrom.GetId());
+        m_connman.PushMessage(
+            &pfrom, msgMaker.Make(NetMsgType::NOTFOUND,
+                                  std::vector<CInv>{CInv(MSG_TX, txid)}));
+        return;
+    }
+
+    m_connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::PKGTXNS, package));
+}
+
+void PeerManagerImpl::ProcessPackageTxns(const Config &config, CNode &pfrom,
+                                         Peer &peer, const Package &package) {
+    AssertLockHeld(cs_main);
+    AssertLockHeld(g_cs_orphans);
+
+    const TxId &child_txid = package.back()->GetId();
+    if (peer.m_package_requests.erase(child_txid) == 0) {
+        LogPrint(BCLog::NET, "Ignoring unsolicited package for tx %s peer=%d\n",
+                 child_txid.ToString(), pfrom.GetId());
+        return;
+    }
+
+    for (const CTransactionRef &tx : package) {
+        pfrom.AddKnownTx(tx->GetId());
+        m_txrequest.ReceivedResponse(pfrom.GetId(), tx->GetId());
+    }
+
+    if (m_mempool.exists(child_txid)) {
+        // The parents arrived in the meantime and the child was accepted.
+        return;
+    }
+
+    const PackageMempoolAcceptResult result =
+        ProcessNewPackage(config, m_chainman.ActiveChainstate(), m_mempool,
+                          package, /* test_accept */ false);
+
+    for (const CTransactionRef &tx : package) {
+        const TxId &txid = tx->GetId();
+        auto it = result.m_tx_results.find(txid);
+        if (it == result.m_tx_results.end()) {
+            continue;
+        }
+
+        const MempoolAcceptResult &tx_result = it->second;
+        switch (tx_result.m_result_type) {
+            case MempoolAcceptResult::ResultType::VALID:
+                LogPrint(BCLog::MEMPOOL,
+                         "   accepted package tx %s from peer=%d\n",
+                         txid.ToString(), pfrom.GetId());
+                pfrom.m_last_tx_time = GetTime<std::chrono::seconds>();
+                m_txrequest.ForgetInvId(txid);
+                RelayTransaction(txid);
+                m_orphanage.AddChildrenToWorkSet(*tx, peer.m_orphan_work_set);
+                m_orphanage.EraseTx(txid);
+                break;
+            case MempoolAcceptResult::ResultType::MEMPOOL_ENTRY:
+                // Already in our mempool, nothing to do.
+                break;
+            case MempoolAcceptResult::ResultType::INVALID:
+                if (tx_result.m_state.GetResult() !=
+                        TxValidationResult::TX_PACKAGE_RECONSIDERABLE &&
+                    tx_result.m_state.GetResult() !=
+                        TxValidationResult::TX_MISSING_INPUTS) {
+                    AddToRecentRejects(txid, tx_result.m_state);
+                    m_orphanage.EraseTx(txid);
+                    MaybePunishNodeForTx(pfrom.GetId(), tx_result.m_state);
+                }
+                break;
+        }
+    }
+
+    if (result.m_state.IsInvalid()) {
+        LogPrint(BCLog::MEMPOOL,
+                 "package for tx %s from peer=%d was not accepted: %s\n",
+                 child_txid.ToString(), pfrom.GetId(),
+                 result.m_state.ToString());
+        return;
+    }
+
+    LogPrint(BCLog::MEMPOOL,
+             "AcceptToMemoryPool: peer=%d: accepted package of %u txs for %s "
+             "(poolsz %u txn, %u kB)\n",
+             pfrom.GetId(), package.size(), child_txid.ToString(),
+             m_mempool.size(), m_mempool.DynamicMemoryUsage() / 1000);
+
+    // Process any orphan transactions that depended on the package.
+    ProcessOrphanTx(config, peer.m_orphan_work_set);
+}
+
 bool PeerManagerImpl::PrepareBlockFilterRequest(
     CNode &peer, const CChainParams &chain_params, BlockFilterType filter_type,
     uint32_t start_height, const BlockHash &stop_hash, uint32_t max_height_diff,
@@ -3580,6 +3898,13 @@ void PeerManagerImpl::ProcessMessage(
         // Signal ADDRv2 support (BIP155).
         m_connman.PushMessage(&pfrom, msg_maker.Make(NetMsgType::SENDADDRV2));
 
+        // Signal package relay support, unless this connection doesn't relay
+        // transactions.
+        if (m_package_relay && pfrom.m_tx_relay != nullptr) {
+            m_connman.PushMessage(&pfrom,
+                                  msg_maker.Make(NetMsgType::SENDPACKAGES));
+        }
+
         pfrom.nServices = nServices;
         pfrom.SetAddrLocal(addrMe);
         {
@@ -3916,6 +4241,11 @@ void PeerManagerImpl::ProcessMessage(
         return;
     }
 
+    if (msg_type == NetMsgType::SENDPACKAGES) {
+        peer->m_wants_packages = true;
+        return;
+    }
+
     if (msg_type == NetMsgType::SENDHEADERS) {
         LOCK(cs_main);
         State(pfrom.GetId())->fPreferHeaders = true;
@@ -4384,6 +4714,10 @@ void PeerManagerImpl::ProcessMessage(
             // It may be the case that the orphans parents have all been
             // rejected.
             bool fRejectedParents = false;
+            // Whether all the rejected parents were rejected only because
+            // their fee rate is too low, in which case they might be accepted
+            // as part of a package.
+            bool fReconsiderableParents = true;
 
             // Deduplicate parent txids, so that we don't have to loop over
             // the same parent txid more than once down below.
@@ -4400,7 +4734,11 @@ void PeerManagerImpl::ProcessMessage(
             for (const TxId &parent_txid : unique_parents) {
                 if (recentRejects->contains(parent_txid)) {
                     fRejectedParents = true;
-                    break;
+                    if (!m_recent_rejects_reconsiderable->contains(
+                            parent_txid)) {
+                        fReconsiderableParents = false;
+                        break;
+                    }
                 }
             }
             if (!fRejectedParents) {
@@ -4414,25 +4752,22 @@ void PeerManagerImpl::ProcessMessage(
                     }
                 }
 
-                if (m_orphanage.AddTx(ptx, pfrom.GetId())) {
-                    AddToCompactExtraTransactions(ptx);
-                }
+                AddOrphanTx(ptx, pfrom.GetId());
 
                 // Once added to the orphan pool, a tx is considered
                 // AlreadyHave, and we shouldn't request it anymore.
                 m_txrequest.ForgetInvId(tx.GetId());
-
-                // DoS prevention: do not allow m_orphanage to grow
-                // unbounded (see CVE-2012-3789)
-                unsigned int nMaxOrphanTx = (unsigned int)std::max(
-                    int64_t(0),
-                    gArgs.GetIntArg("-maxorphantx",
-                                    DEFAULT_MAX_ORPHAN_TRANSACTIONS));
-                unsigned int nEvicted = m_orphanage.LimitOrphans(nMaxOrphanTx);
-                if (nEvicted > 0) {
-                    LogPrint(BCLog::MEMPOOL,
-                             "orphanage overflow, removed %u tx\n", nEvicted);
-                }
+            } else if (fReconsiderableParents && CanRequestPackage(*peer) &&
+                       AddOrphanTx(ptx, pfrom.GetId())) {
+                // The parents were rejected only because their fee rate is too
+                // low. Keep the orphan until the package is received, and give
+                // the child a chance to pay for them.
+                LogPrint(BCLog::MEMPOOL,
+                         "requesting package for orphan with low fee parents "
+                         "%s from peer=%d\n",
+                         tx.GetId().ToString(), pfrom.GetId());
+                RequestPackage(pfrom, *peer, tx.GetId());
+                m_txrequest.ForgetInvId(tx.GetId());
             } else {
                 LogPrint(BCLog::MEMPOOL,
                          "not keeping orphan with rejected parents %s\n",
@@ -4443,13 +4778,19 @@ void PeerManagerImpl::ProcessMessage(
                 m_txrequest.ForgetInvId(tx.GetId());
             }
         } else {
-            assert(recentRejects);
-            recentRejects->insert(tx.GetId());
+            AddToRecentRejects(tx.GetId(), state);
             m_txrequest.ForgetInvId(tx.GetId());
 
             if (RecursiveDynamicUsage(*ptx) < 100000) {
                 AddToCompactExtraTransactions(ptx);
             }
+
+            // The orphans from this peer that spend this transaction might
+            // pay for it if evaluated as a package.
+            if (state.GetResult() ==
+                TxValidationResult::TX_PACKAGE_RECONSIDERABLE) {
+                RequestPackagesForOrphanChildren(pfrom, *peer, tx);
+            }
         }
 
         // If a tx has been detected by recentRejects, we will have reached
@@ -5715,6 +6056,42 @@ void PeerManagerImpl::ProcessMessage(
         return;
     }
 
+    if (msg_type == NetMsgType::GETPKGTXNS) {
+        TxId txid;
+        vRecv >> txid;
+        if (!m_package_relay || pfrom.m_tx_relay == nullptr) {
+            LogPrint(BCLog::NET,
+                     "getpkgtxns sent in violation of protocol peer=%d\n",
+                     pfrom.GetId());
+            pfrom.fDisconnect = true;
+            return;
+        }
+        ProcessGetPackageTxns(pfrom, txid);
+        return;
+    }
+
+    if (msg_type == NetMsgType::PKGTXNS) {
+        if (m_ignore_incoming_txs || pfrom.m_tx_relay == nullptr) {
+            LogPrint(BCLog::NET,
+                     "pkgtxns sent in violation of protocol peer=%d\n",
+                     pfrom.GetId());
+            pfrom.fDisconnect = true;
+            return;
+        }
+
+        Package package;
+        vRecv >> package;
+        if (package.empty() || package.size() > MAX_PACKAGE_COUNT) {
+            Misbehaving(pfrom, 20,
+                        strprintf("pkgtxns message size = %u", package.size()));
+            return;
+        }
+
+        LOCK2(cs_main, g_cs_orphans);
+        ProcessPackageTxns(config, pfrom, *peer, package);
+        return;
+    }
+
     if (msg_type == NetMsgType::NOTFOUND) {
         std::vector<CInv> vInv;
         vRecv >> vInv;
@@ -5727,8 +6104,14 @@ void PeerManagerImpl::ProcessMessage(
                     // If we receive a NOTFOUND message for a tx we requested,
                     // mark the announcement for it as completed in
                     // InvRequestTracker.
-                    LOCK(::cs_main);
-                    m_txrequest.ReceivedResponse(pfrom.GetId(), TxId(inv.hash));
+                    LOCK2(::cs_main, g_cs_orphans);
+                    // A NOTFOUND for a txid we sent a getpkgtxns for is the
+                    // answer to that request. The txid is an orphan, so it
+                    // can't have been requested with a getdata.
+                    if (peer->m_package_requests.erase(TxId(inv.hash)) == 0) {
+                        m_txrequest.ReceivedResponse(pfrom.GetId(),
+                                                     TxId(inv.hash));
+                    }
                     continue;
                 }
                 if (inv.IsMsgProof()) {
@@ -5804,14 +6187,15 @@ bool PeerManagerImpl::ProcessMessages(const Config &config, CNode *pfrom,
     //  (4) checksum
     //  (x) data
     //
-    bool fMoreWork = false;
-
     PeerRef peer = GetPeerRef(pfrom->GetId());
     if (peer == nullptr) {
         return false;
     }
 
-    {
+    // The data requests are served by the message workers, if any.
+    const bool use_workers = m_connman.GetMessageWorkers() > 0;
+
+    if (!use_workers) {
         LOCK(peer->m_getdata_requests_mutex);
         if (!peer->m_getdata_requests.empty()) {
             ProcessGetData(config, *pfrom, *peer, interruptMsgProc);
@@ -5834,7 +6218,8 @@ bool PeerManagerImpl::ProcessMessages(const Config &config, CNode *pfrom,
     {
         LOCK(peer->m_getdata_requests_mutex);
         if (!peer->m_getdata_requests.empty()) {
-            return true;
+            // The message workers hand the node back once they are served.
+            return !use_workers;
         }
     }
 
@@ -5850,12 +6235,84 @@ bool PeerManagerImpl::ProcessMessages(const Config &config, CNode *pfrom,
         return false;
     }
 
+    return ProcessNextMessage(config, pfrom, *peer, interruptMsgProc,
+                              /* read_only */ false);
+}
+
+bool PeerManagerImpl::ProcessReadOnlyMessages(
+    const Config &config, CNode *pfrom, std::atomic<bool> &interruptMsgProc) {
+    PeerRef peer = GetPeerRef(pfrom->GetId());
+    if (peer == nullptr) {
+        return false;
+    }
+
+    {
+        LOCK(peer->m_getdata_requests_mutex);
+        if (!peer->m_getdata_requests.empty()) {
+            ProcessGetData(config, *pfrom, *peer, interruptMsgProc);
+            // this maintains the order of responses
+            if (!peer->m_getdata_requests.empty()) {
+                return true;
+            }
+        }
+    }
+
+    if (pfrom->fDisconnect) {
+        return false;
+    }
+
+    // The orphans are processed by the message handler before the next
+    // message.
+    if (WITH_LOCK(g_cs_orphans, return !peer->m_orphan_work_set.empty())) {
+        pfrom->m_msg_process_handoff = true;
+        return false;
+    }
+
+    // Don't bother if send buffer is too full to respond anyway
+    if (pfrom->fPauseSend) {
+        return false;
+    }
+
+    return ProcessNextMessage(config, pfrom, *peer, interruptMsgProc,
+                              /* read_only */ true);
+}
+
+bool PeerManagerImpl::IsReadOnlyMessage(const CNode &pfrom,
+                                        const CNetMessage &msg) {
+    // Malformed messages and messages received before the handshake is
+    // complete are left to the message handler, which penalizes the peer.
+    if (!pfrom.fSuccessfullyConnected || !msg.m_valid_netmagic ||
+        !msg.m_valid_header || !msg.m_valid_checksum) {
+        return false;
+    }
+
+    // getaddr is not included, as the addresses queued for a peer can be
+    // modified while processing the messages of other peers.
+    return msg.m_command == NetMsgType::GETDATA ||
+           msg.m_command == NetMsgType::GETHEADERS ||
+           msg.m_command == NetMsgType::PING;
+}
+
+bool PeerManagerImpl::ProcessNextMessage(const Config &config, CNode *pfrom,
+                                         Peer &peer,
+                                         std::atomic<bool> &interruptMsgProc,
+                                         bool read_only) {
+    bool fMoreWork = false;
+
     std::list<CNetMessage> msgs;
     {
         LOCK(pfrom->cs_vProcessMsg);
         if (pfrom->vProcessMsg.empty()) {
             return false;
         }
+        if (m_connman.GetMessageWorkers() > 0 &&
+            IsReadOnlyMessage(*pfrom, pfrom->vProcessMsg.front()) !=
+                read_only) {
+            // The message is processed by the other kind of thread, which is
+            // woken up once the node is released.
+            pfrom->m_msg_process_handoff = true;
+            return false;
+        }
         // Just take one message
         msgs.splice(msgs.begin(), pfrom->vProcessMsg,
                     pfrom->vProcessMsg.begin());
@@ -5921,8 +6378,8 @@ bool PeerManagerImpl::ProcessMessages(const Config &config, CNode *pfrom,
         }
 
         {
-            LOCK(peer->m_getdata_requests_mutex);
-            if (!peer->m_getdata_requests.empty()) {
+            LOCK(peer.m_getdata_requests_mutex);
+            if (!peer.m_getdata_requests.empty()) {
                 fMoreWork = true;
             }
         }
@@ -6,7 +6,8 @@
 
 #include <policy/fees.h>
 
-#include <feerate.h>
+#include <algorithm>
+#include <cassert>
 
 FeeFilterRounder::FeeFilterRounder(const CFeeRate &minIncrementalFee) {
     Amount minFeeLimit = std::max(SATOSHI, minIncrementalFee.GetFeePerK() / 2);
@@ -27,3 +28,65 @@ Amount FeeFilterRounder::round(const Amount currentMinFee) {
 
     return *it;
 }
+
+FeeRateHistogram::FeeRateHistogram() {
+    // The first bucket catches everything below MIN_FEERATE, including the
+    // transactions with a negative modified fee.
+    m_buckets.push_back({CFeeRate(Amount::zero())});
+    for (double bucketBoundary = MIN_FEERATE / SATOSHI;
+         bucketBoundary <= double(MAX_FEERATE / SATOSHI);
+         bucketBoundary *= FEE_SPACING) {
+        m_buckets.push_back({CFeeRate(int64_t(bucketBoundary) * SATOSHI)});
+    }
+}
+
+FeeRateHistogram::Bucket &FeeRateHistogram::GetBucket(const Amount fee,
+                                                      size_t size) {
+    const CFeeRate feerate(fee, size);
+    auto it = std::upper_bound(
+        m_buckets.begin(), m_buckets.end(), feerate,
+        [](const CFeeRate &rate, const Bucket &bucket) {
+            return rate < bucket.min_fee_rate;
+        });
+    if (it != m_buckets.begin()) {
+        it--;
+    }
+    return *it;
+}
+
+void FeeRateHistogram::AddTx(const Amount fee, size_t size) {
+    Bucket &bucket = GetBucket(fee, size);
+    bucket.count++;
+    bucket.size += size;
+    bucket.fees += fee;
+}
+
+void FeeRateHistogram::RemoveTx(const Amount fee, size_t size) {
+    Bucket &bucket = GetBucket(fee, size);
+    assert(bucket.count > 0 && bucket.size >= size);
+    bucket.count--;
+    bucket.size -= size;
+    bucket.fees -= fee;
+}
+
+void FeeRateHistogram::Clear() {
+    for (Bucket &bucket : m_buckets) {
+        bucket.count = 0;
+        bucket.size = 0;
+        bucket.fees = Amount::zero();
+    }
+}
+
+CFeeRate FeeRateHistogram::GetFeeRateForSize(uint64_t max_size) const {
+    uint64_t cumulative_size = 0;
+    for (size_t i = m_buckets.size(); i-- > 0;) {
+        cumulative_size += m_buckets[i].size;
+        if (cumulative_size > max_size) {
+            // This bucket doesn't fit entirely, so only a fee rate above all
+            // of its transactions is guaranteed to make it.
+            return i + 1 < m_buckets.size() ? m_buckets[i + 1].min_fee_rate
+                                            : m_buckets[i].min_fee_rate;
+        }
+    }
+    return CFeeRate(Amount::zero());
+}
@@ -6,6 +6,7 @@
 #define BITCOIN_POLICY_FEES_H
 
 #include <consensus/amount.h>
+#include <feerate.h>
 #include <random.h>
 #include <uint256.h>
 
@@ -13,8 +14,6 @@
 #include <string>
 #include <vector>
 
-class CFeeRate;
-
 // Minimum and Maximum values for tracking feerates
 static constexpr Amount MIN_FEERATE(10 * SATOSHI);
 static const Amount MAX_FEERATE(int64_t(1e7) * SATOSHI);
@@ -41,4 +40,43 @@ private:
     FastRandomContext insecure_rand;
 };
 
+/**
+ * Histogram of transactions by fee rate, using exponentially spaced buckets
+ * between MIN_FEERATE and MAX_FEERATE. It is kept up to date as transactions
+ * enter and leave the mempool, so fee queries only walk the buckets instead of
+ * sorting the whole mempool.
+ */
+class FeeRateHistogram {
+public:
+    struct Bucket {
+        //! Lowest fee rate of the transactions in this bucket
+        CFeeRate min_fee_rate;
+        uint64_t count{0};
+        uint64_t size{0};
+        Amount fees{Amount::zero()};
+    };
+
+    FeeRateHistogram();
+
+    void AddTx(const Amount fee, size_t size);
+    void RemoveTx(const Amount fee, size_t size);
+    void Clear();
+
+    /** Buckets in increasing fee rate order, including the empty ones. */
+    const std::vector<Bucket> &GetBuckets() const { return m_buckets; }
+
+    /**
+     * Get the fee rate a transaction needs to be ahead of everything beyond
+     * the first max_size bytes of transactions, taken by decreasing fee rate.
+     * The result is rounded up to a bucket boundary. Returns a zero fee rate
+     * if all the transactions fit within max_size.
+     */
+    CFeeRate GetFeeRateForSize(uint64_t max_size) const;
+
+private:
+    std::vector<Bucket> m_buckets;
+
+    Bucket &GetBucket(const Amount fee, size_t size);
+};
+
 #endif // BITCOIN_POLICY_FEES_H
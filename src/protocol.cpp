@@ -55,6 +55,9 @@ const char *GETAVAADDR = "getavaaddr";
 const char *GETAVAPROOFS = "getavaproofs";
 const char *AVAPROOFS = "avaproofs";
 const char *AVAPROOFSREQ = "avaproofsreq";
+const char *SENDPACKAGES = "sendpackages";
+const char *GETPKGTXNS = "getpkgtxns";
+const char *PKGTXNS = "pkgtxns";
 
 bool IsBlockLike(const std::string &strCommand) {
     return strCommand == NetMsgType::BLOCK ||
@@ -68,17 +71,24 @@ bool IsBlockLike(const std::string &strCommand) {
  * above and in protocol.h.
  */
 static const std::string allNetMessageTypes[] = {
-    NetMsgType::VERSION,     NetMsgType::VERACK,       NetMsgType::ADDR,
-    NetMsgType::ADDRV2,      NetMsgType::SENDADDRV2,   NetMsgType::INV,
-    NetMsgType::GETDATA,     NetMsgType::MERKLEBLOCK,  NetMsgType::GETBLOCKS,
-    NetMsgType::GETHEADERS,  NetMsgType::TX,           NetMsgType::HEADERS,
-    NetMsgType::BLOCK,       NetMsgType::GETADDR,      NetMsgType::MEMPOOL,
-    NetMsgType::PING,        NetMsgType::PONG,         NetMsgType::NOTFOUND,
-    NetMsgType::FILTERLOAD,  NetMsgType::FILTERADD,    NetMsgType::FILTERCLEAR,
-    NetMsgType::SENDHEADERS, NetMsgType::FEEFILTER,    NetMsgType::SENDCMPCT,
-    NetMsgType::CMPCTBLOCK,  NetMsgType::GETBLOCKTXN,  NetMsgType::BLOCKTXN,
-    NetMsgType::GETCFILTERS, NetMsgType::CFILTER,      NetMsgType::GETCFHEADERS,
-    NetMsgType::CFHEADERS,   NetMsgType::GETCFCHECKPT, NetMsgType::CFCHECKPT,
+    NetMsgType::VERSION,     NetMsgType::VERACK,
+    NetMsgType::ADDR,        NetMsgType::ADDRV2,
+    NetMsgType::SENDADDRV2,  NetMsgType::INV,
+    NetMsgType::GETDATA,     NetMsgType::MERKLEBLOCK,
+    NetMsgType::GETBLOCKS,   NetMsgType::GETHEADERS,
+    NetMsgType::TX,          NetMsgType::HEADERS,
+    NetMsgType::BLOCK,       NetMsgType::GETADDR,
+    NetMsgType::MEMPOOL,     NetMsgType::PING,
+    NetMsgType::PONG,        NetMsgType::NOTFOUND,
+    NetMsgType::FILTERLOAD,  NetMsgType::FILTERADD,
+    NetMsgType::FILTERCLEAR, NetMsgType::SENDHEADERS,
+    NetMsgType::FEEFILTER,   NetMsgType::SENDCMPCT,
+    NetMsgType::CMPCTBLOCK,  NetMsgType::GETBLOCKTXN,
+    NetMsgType::BLOCKTXN,    NetMsgType::GETCFILTERS,
+    NetMsgType::CFILTER,     NetMsgType::GETCFHEADERS,
+    NetMsgType::CFHEADERS,   NetMsgType::GETCFCHECKPT,
+    NetMsgType::CFCHECKPT,   NetMsgType::SENDPACKAGES,
+    NetMsgType::GETPKGTXNS,  NetMsgType::PKGTXNS,
 };
 static const std::vector<std::string>
     allNetMessageTypesVec(std::begin(allNetMessageTypes),
@@ -321,6 +321,28 @@ extern const char *AVAPROOFS;
  */
 extern const char *AVAPROOFSREQ;
 
+/**
+ * The sendpackages message signals support for package relay. Its sender will
+ * answer getpkgtxns requests and may send getpkgtxns itself for transactions
+ * whose parents it is missing.
+ */
+extern const char *SENDPACKAGES;
+
+/**
+ * The getpkgtxns message requests the child-with-unconfirmed-parents package
+ * of a transaction, identified by its txid.
+ * Peer should respond with a "pkgtxns" message, or with a "notfound" message
+ * if the package cannot be served.
+ */
+extern const char *GETPKGTXNS;
+
+/**
+ * Contains a topologically sorted package made of a transaction preceded by
+ * all of its unconfirmed parents.
+ * Sent in response to a "getpkgtxns" message.
+ */
+extern const char *PKGTXNS;
+
 /**
  * Indicate if the message is used to transmit the content of a block.
  * These messages can be significantly larger than usual messages and therefore
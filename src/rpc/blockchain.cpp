@@ -636,15 +636,9 @@ UniValue MempoolToJSON(const CTxMemPool &pool, bool verbose,
         }
         return o;
     } else {
-        uint64_t mempool_sequence;
-        std::vector<uint256> vtxids;
-        {
-            LOCK(pool.cs);
-            pool.queryHashes(vtxids);
-            mempool_sequence = pool.GetSequence();
-        }
+        const RCUPtr<const MempoolSnapshot> snapshot = pool.GetSnapshot();
         UniValue a(UniValue::VARR);
-        for (const uint256 &txid : vtxids) {
+        for (const TxId &txid : snapshot->txids) {
             a.push_back(txid.ToString());
         }
 
@@ -653,7 +647,7 @@ UniValue MempoolToJSON(const CTxMemPool &pool, bool verbose,
         } else {
             UniValue o(UniValue::VOBJ);
             o.pushKV("txids", a);
-            o.pushKV("mempool_sequence", mempool_sequence);
+            o.pushKV("mempool_sequence", snapshot->sequence);
             return o;
         }
     }
@@ -2053,22 +2047,21 @@ static RPCHelpMan getchaintips() {
 }
 
 UniValue MempoolInfoToJSON(const CTxMemPool &pool) {
-    // Make sure this call is atomic in the pool.
-    LOCK(pool.cs);
+    // Use a snapshot so this call is atomic without locking the pool.
+    const RCUPtr<const MempoolSnapshot> snapshot = pool.GetSnapshot();
     UniValue ret(UniValue::VOBJ);
-    ret.pushKV("loaded", pool.IsLoaded());
-    ret.pushKV("size", (int64_t)pool.size());
-    ret.pushKV("bytes", (int64_t)pool.GetTotalTxSize());
-    ret.pushKV("usage", (int64_t)pool.DynamicMemoryUsage());
-    ret.pushKV("total_fee", pool.GetTotalFee());
+    ret.pushKV("loaded", snapshot->loaded);
+    ret.pushKV("size", (int64_t)snapshot->txids.size());
+    ret.pushKV("bytes", (int64_t)snapshot->total_tx_size);
+    ret.pushKV("usage", (int64_t)snapshot->dynamic_usage);
+    ret.pushKV("total_fee", snapshot->total_fee);
     size_t maxmempool =
         gArgs.GetIntArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000;
     ret.pushKV("maxmempool", (int64_t)maxmempool);
-    ret.pushKV(
-        "mempoolminfee",
-        std::max(pool.GetMinFee(maxmempool), ::minRelayTxFee).GetFeePerK());
+    ret.pushKV("mempoolminfee",
+               std::max(snapshot->min_fee, ::minRelayTxFee).GetFeePerK());
     ret.pushKV("minrelaytxfee", ::minRelayTxFee.GetFeePerK());
-    ret.pushKV("unbroadcastcount", uint64_t{pool.GetUnbroadcastTxs().size()});
+    ret.pushKV("unbroadcastcount", uint64_t{snapshot->unbroadcast_count});
     return ret;
 }
 
@@ -2113,6 +2106,66 @@ static RPCHelpMan getmempoolinfo() {
     };
 }
 
+static RPCHelpMan getfeehistogram() {
+    const auto &ticker = Currency::get().ticker;
+    return RPCHelpMan{
+        "getfeehistogram",
+        "Returns the mempool transactions grouped by modified fee rate, from "
+        "the highest fee rate to the lowest. Empty groups are omitted.\n",
+        {},
+        RPCResult{
+            RPCResult::Type::ARR,
+            "",
+            "",
+            {
+                {RPCResult::Type::OBJ,
+                 "",
+                 "",
+                 {
+                     {RPCResult::Type::STR_AMOUNT, "feerate",
+                      "Lowest fee rate of the group in " + ticker + "/kB"},
+                     {RPCResult::Type::NUM, "count",
+                      "Number of transactions in the group"},
+                     {RPCResult::Type::NUM, "size",
+                      "Sum of the transaction sizes in the group"},
+                     {RPCResult::Type::STR_AMOUNT, "fees",
+                      "Sum of the transaction modified fees in the group in " +
+                          ticker},
+                     {RPCResult::Type::NUM, "cumulativesize",
+                      "Sum of the transaction sizes in this group and all the "
+                      "groups with a higher fee rate"},
+                 }},
+            }},
+        RPCExamples{HelpExampleCli("getfeehistogram", "") +
+                    HelpExampleRpc("getfeehistogram", "")},
+        [&](const RPCHelpMan &self, const Config &config,
+            const JSONRPCRequest &request) -> UniValue {
+            const RCUPtr<const MempoolSnapshot> snapshot =
+                EnsureAnyMemPool(request.context).GetSnapshot();
+            const std::vector<FeeRateHistogram::Bucket> &buckets =
+                snapshot->fee_histogram.GetBuckets();
+
+            UniValue ret(UniValue::VARR);
+            uint64_t cumulative_size = 0;
+            for (auto it = buckets.rbegin(); it != buckets.rend(); ++it) {
+                if (it->count == 0) {
+                    continue;
+                }
+                cumulative_size += it->size;
+
+                UniValue bucket(UniValue::VOBJ);
+                bucket.pushKV("feerate", it->min_fee_rate.GetFeePerK());
+                bucket.pushKV("count", it->count);
+                bucket.pushKV("size", it->size);
+                bucket.pushKV("fees", it->fees);
+                bucket.pushKV("cumulativesize", cumulative_size);
+                ret.push_back(bucket);
+            }
+            return ret;
+        },
+    };
+}
+
 static RPCHelpMan preciousblock() {
     return RPCHelpMan{
         "preciousblock",
@@ -2790,13 +2843,14 @@ static RPCHelpMan savemempool() {
         [&](const RPCHelpMan &self, const Config &config,
             const JSONRPCRequest &request) -> UniValue {
             const CTxMemPool &mempool = EnsureAnyMemPool(request.context);
+            ChainstateManager &chainman = EnsureAnyChainman(request.context);
 
             if (!mempool.IsLoaded()) {
                 throw JSONRPCError(RPC_MISC_ERROR,
                                    "The mempool was not loaded yet");
             }
 
-            if (!DumpMempool(mempool)) {
+            if (!DumpMempool(mempool, chainman.ActiveChainstate())) {
                 throw JSONRPCError(RPC_MISC_ERROR,
                                    "Unable to dump mempool to disk");
             }
@@ -3339,6 +3393,7 @@ void RegisterBlockchainRPCCommands(CRPCTable &t) {
         { "blockchain",         getmempooldescendants,             },
         { "blockchain",         getmempoolentry,                   },
         { "blockchain",         getmempoolinfo,                    },
+        { "blockchain",         getfeehistogram,                   },
         { "blockchain",         getrawmempool,                     },
         { "blockchain",         gettxout,                          },
         { "blockchain",         gettxoutsetinfo,                   },
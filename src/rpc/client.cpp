@@ -134,6 +134,7 @@ static const CRPCConvertParam vRPCConvertParams[] = {
     {"getrawmempool", 1, "mempool_sequence"},
     {"prioritisetransaction", 1, "dummy"},
     {"prioritisetransaction", 2, "fee_delta"},
+    {"estimatefee", 0, "nblocks"},
     {"setban", 2, "bantime"},
     {"setban", 3, "absolute"},
     {"setnetworkactive", 0, "state"},
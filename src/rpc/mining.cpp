@@ -40,6 +40,9 @@
 
 #include <cstdint>
 
+/** Maximum nblocks for estimatefee, one week worth of blocks. */
+static constexpr int MAX_ESTIMATEFEE_BLOCKS{1008};
+
 /**
  * Return average network hashes per second based on the last 'lookup' blocks,
  * or from the last difficulty change if 'lookup' is nonpositive. If 'height' is
@@ -1213,13 +1216,39 @@ static RPCHelpMan estimatefee() {
         "estimatefee",
         "Estimates the approximate fee per kilobyte needed for a "
         "transaction\n",
-        {},
+        {
+            {"nblocks", RPCArg::Type::NUM, RPCArg::Optional::OMITTED_NAMED_ARG,
+             "Estimate the fee rate needed to be mined within nblocks blocks "
+             "(1 - " +
+                 ToString(MAX_ESTIMATEFEE_BLOCKS) +
+                 "), assuming blocks are filled with the mempool transactions "
+                 "by decreasing fee rate. If omitted, only the minimum fee "
+                 "rate to be accepted in the mempool is returned."},
+        },
         RPCResult{RPCResult::Type::NUM, "", "estimated fee-per-kilobyte"},
-        RPCExamples{HelpExampleCli("estimatefee", "")},
+        RPCExamples{HelpExampleCli("estimatefee", "") +
+                    HelpExampleCli("estimatefee", "6")},
         [&](const RPCHelpMan &self, const Config &config,
             const JSONRPCRequest &request) -> UniValue {
             const CTxMemPool &mempool = EnsureAnyMemPool(request.context);
-            return mempool.estimateFee().GetFeePerK();
+            if (request.params[0].isNull()) {
+                return mempool.estimateFee().GetFeePerK();
+            }
+
+            const int nblocks = request.params[0].get_int();
+            if (nblocks < 1 || nblocks > MAX_ESTIMATEFEE_BLOCKS) {
+                throw JSONRPCError(
+                    RPC_INVALID_PARAMETER,
+                    strprintf("Invalid nblocks, must be between 1 and %d",
+                              MAX_ESTIMATEFEE_BLOCKS));
+            }
+            ChainstateManager &chainman = EnsureAnyChainman(request.context);
+            // The miner keeps 1000 bytes for the block header and coinbase.
+            const uint64_t block_size =
+                BlockAssembler(config, chainman.ActiveChainstate(), mempool)
+                    .GetMaxGeneratedBlockSize() -
+                1000;
+            return mempool.estimateFee(nblocks, block_size).GetFeePerK();
         },
     };
 }
@@ -305,6 +305,92 @@ BOOST_AUTO_TEST_CASE(MempoolClearTest) {
     BOOST_CHECK_EQUAL(testPool.vTxHashes.size(), 0UL);
 }
 
+BOOST_AUTO_TEST_CASE(MempoolSnapshotTest) {
+    TestMemPoolEntryHelper entry;
+    CMutableTransaction tx;
+    tx.vin.resize(1);
+    tx.vin[0].scriptSig = CScript() << OP_11;
+    tx.vout.resize(1);
+    tx.vout[0].scriptPubKey = CScript() << OP_11 << OP_EQUAL;
+    tx.vout[0].nValue = 33000 * SATOSHI;
+
+    CTxMemPool testPool;
+    LOCK2(cs_main, testPool.cs);
+
+    const RCUPtr<const MempoolSnapshot> empty = testPool.GetSnapshot();
+    BOOST_CHECK(empty->txids.empty());
+    BOOST_CHECK_EQUAL(empty->total_tx_size, 0UL);
+    BOOST_CHECK_EQUAL(empty->total_fee, Amount::zero());
+
+    // The snapshot is reused as long as the mempool doesn't change
+    BOOST_CHECK(testPool.GetSnapshot() == empty);
+
+    testPool.addUnchecked(entry.Fee(1000 * SATOSHI).FromTx(tx));
+    const RCUPtr<const MempoolSnapshot> one = testPool.GetSnapshot();
+    BOOST_CHECK(one != empty);
+    BOOST_CHECK_EQUAL(one->txids.size(), 1UL);
+    BOOST_CHECK(one->txids[0] == tx.GetId());
+    BOOST_CHECK_EQUAL(one->total_tx_size, testPool.GetTotalTxSize());
+    BOOST_CHECK_EQUAL(one->total_fee, 1000 * SATOSHI);
+    BOOST_CHECK_EQUAL(one->dynamic_usage, testPool.DynamicMemoryUsage());
+    BOOST_CHECK_EQUAL(one->sequence, testPool.GetSequence());
+    BOOST_CHECK_EQUAL(one->unbroadcast_count, 0UL);
+
+    testPool.AddUnbroadcastTx(tx.GetId());
+    const RCUPtr<const MempoolSnapshot> unbroadcast = testPool.GetSnapshot();
+    BOOST_CHECK(unbroadcast != one);
+    BOOST_CHECK_EQUAL(unbroadcast->unbroadcast_count, 1UL);
+
+    // The previous snapshots are unaffected by the changes
+    BOOST_CHECK(empty->txids.empty());
+    BOOST_CHECK_EQUAL(one->unbroadcast_count, 0UL);
+
+    testPool.removeRecursive(CTransaction(tx), REMOVAL_REASON_DUMMY);
+    const RCUPtr<const MempoolSnapshot> removed = testPool.GetSnapshot();
+    BOOST_CHECK(removed->txids.empty());
+    BOOST_CHECK_EQUAL(removed->unbroadcast_count, 0UL);
+    BOOST_CHECK_EQUAL(removed->total_fee, Amount::zero());
+}
+
+BOOST_AUTO_TEST_CASE(MempoolFeeHistogramTest) {
+    TestMemPoolEntryHelper entry;
+    CMutableTransaction tx;
+    tx.vin.resize(1);
+    tx.vin[0].scriptSig = CScript() << OP_11;
+    tx.vout.resize(1);
+    tx.vout[0].scriptPubKey = CScript() << OP_11 << OP_EQUAL;
+    tx.vout[0].nValue = 33000 * SATOSHI;
+
+    CTxMemPool testPool;
+    LOCK2(cs_main, testPool.cs);
+
+    testPool.addUnchecked(entry.Fee(10000 * SATOSHI).FromTx(tx));
+    const uint64_t tx_size = testPool.GetTotalTxSize();
+
+    // The transaction fits in the block, so only the minimum fee applies
+    BOOST_CHECK(testPool.estimateFee(1, tx_size) == testPool.estimateFee());
+    // Otherwise it has to be outbid
+    BOOST_CHECK(testPool.estimateFee(1, tx_size - 1) >
+                CFeeRate(10000 * SATOSHI, tx_size));
+    BOOST_CHECK(testPool.estimateFee(2, tx_size - 1) == testPool.estimateFee());
+
+    RCUPtr<const MempoolSnapshot> snapshot = testPool.GetSnapshot();
+    BOOST_CHECK(snapshot->fee_histogram.GetFeeRateForSize(0) ==
+                testPool.estimateFee(1, tx_size - 1));
+
+    // The histogram tracks the modified fee
+    testPool.PrioritiseTransaction(tx.GetId(), -10000 * SATOSHI);
+    BOOST_CHECK(testPool.estimateFee(1, tx_size - 1) == testPool.estimateFee());
+    snapshot = testPool.GetSnapshot();
+    BOOST_CHECK_EQUAL(snapshot->fee_histogram.GetBuckets().front().count, 1UL);
+    BOOST_CHECK_EQUAL(snapshot->fee_histogram.GetBuckets().front().size,
+                      tx_size);
+
+    testPool.removeRecursive(CTransaction(tx), REMOVAL_REASON_DUMMY);
+    snapshot = testPool.GetSnapshot();
+    BOOST_CHECK(snapshot->fee_histogram.GetFeeRateForSize(0) == CFeeRate());
+}
+
 template <typename name>
 static void CheckSort(CTxMemPool &pool, std::vector<std::string> &sortedOrder,
                       const std::string &testcase)
@@ -31,4 +31,60 @@ BOOST_AUTO_TEST_CASE(FeeRounder) {
     BOOST_CHECK_EQUAL(fee_rounder.round(MAX_MONEY), 9170997 * SATOSHI);
 }
 
+BOOST_AUTO_TEST_CASE(FeeHistogram) {
+    FeeRateHistogram histogram;
+    BOOST_CHECK(histogram.GetFeeRateForSize(0) == CFeeRate());
+
+    const auto check_totals = [&](uint64_t count, uint64_t size, Amount fees) {
+        uint64_t total_count = 0;
+        uint64_t total_size = 0;
+        Amount total_fees = Amount::zero();
+        for (const FeeRateHistogram::Bucket &bucket : histogram.GetBuckets()) {
+            total_count += bucket.count;
+            total_size += bucket.size;
+            total_fees += bucket.fees;
+        }
+        BOOST_CHECK_EQUAL(total_count, count);
+        BOOST_CHECK_EQUAL(total_size, size);
+        BOOST_CHECK_EQUAL(total_fees, fees);
+    };
+
+    // 10000 sat/kB and 1000 sat/kB
+    histogram.AddTx(10000 * SATOSHI, 1000);
+    histogram.AddTx(1000 * SATOSHI, 1000);
+    check_totals(2, 2000, 11000 * SATOSHI);
+
+    // Everything fits
+    BOOST_CHECK(histogram.GetFeeRateForSize(2000) == CFeeRate());
+    // Only the highest fee rate transaction fits, the estimate is in between
+    // the two fee rates.
+    const CFeeRate one_tx = histogram.GetFeeRateForSize(1000);
+    BOOST_CHECK(one_tx > CFeeRate(1000 * SATOSHI));
+    BOOST_CHECK(one_tx <= CFeeRate(10000 * SATOSHI));
+    // Nothing fits, the estimate outbids the highest fee rate.
+    BOOST_CHECK(histogram.GetFeeRateForSize(999) > CFeeRate(10000 * SATOSHI));
+
+    // Negative fees go to the lowest bucket
+    histogram.AddTx(-100 * SATOSHI, 500);
+    BOOST_CHECK_EQUAL(histogram.GetBuckets().front().count, 1UL);
+    BOOST_CHECK(histogram.GetFeeRateForSize(2000) ==
+                histogram.GetBuckets()[1].min_fee_rate);
+    check_totals(3, 2500, 10900 * SATOSHI);
+
+    histogram.RemoveTx(10000 * SATOSHI, 1000);
+    check_totals(2, 1500, 900 * SATOSHI);
+    BOOST_CHECK(histogram.GetFeeRateForSize(999) > CFeeRate(1000 * SATOSHI));
+    BOOST_CHECK(histogram.GetFeeRateForSize(999) < CFeeRate(10000 * SATOSHI));
+
+    // Fee rates above MAX_FEERATE go to the highest bucket
+    histogram.AddTx(MAX_MONEY, 1000);
+    BOOST_CHECK_EQUAL(histogram.GetBuckets().back().count, 1UL);
+    BOOST_CHECK(histogram.GetFeeRateForSize(0) ==
+                histogram.GetBuckets().back().min_fee_rate);
+
+    histogram.Clear();
+    check_totals(0, 0, Amount::zero());
+    BOOST_CHECK(histogram.GetFeeRateForSize(0) == CFeeRate());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -421,4 +421,123 @@ BOOST_FIXTURE_TEST_CASE(package_submission_tests, TestChain100Setup) {
                           "txn-already-known");
     }
 }
+
+BOOST_FIXTURE_TEST_CASE(package_cpfp_tests, TestChain100Setup) {
+    const Config &config = GetConfig();
+    unsigned int expected_pool_size = m_node.mempool->size();
+
+    // A parent paying no fee at all.
+    CKey parent_key;
+    parent_key.MakeNewKey(true);
+    CScript parent_locking_script =
+        GetScriptForDestination(PKHash(parent_key.GetPubKey()));
+    const Amount coinbase_value = m_coinbase_txns[0]->vout[0].nValue;
+    auto mtx_parent = CreateValidMempoolTransaction(
+        /*input_transaction=*/m_coinbase_txns[0], /*vout=*/0,
+        /*input_height=*/0, /*input_signing_key=*/coinbaseKey,
+        /*output_destination=*/parent_locking_script,
+        /*output_amount=*/coinbase_value, /*submit=*/false);
+    CTransactionRef tx_parent = MakeTransactionRef(mtx_parent);
+
+    // The parent is rejected on its own.
+    {
+        LOCK(cs_main);
+        const auto result_parent_only = AcceptToMemoryPool(
+            config, m_node.chainman->ActiveChainstate(), tx_parent, GetTime(),
+            /*bypass_limits=*/false, /*test_accept=*/false);
+        BOOST_CHECK(result_parent_only.m_result_type ==
+                    MempoolAcceptResult::ResultType::INVALID);
+        BOOST_CHECK_EQUAL(result_parent_only.m_state.GetRejectReason(),
+                          "min relay fee not met");
+        BOOST_CHECK_EQUAL(m_node.mempool->size(), expected_pool_size);
+    }
+
+    CKey child_key;
+    child_key.MakeNewKey(true);
+    CScript child_locking_script =
+        GetScriptForDestination(PKHash(child_key.GetPubKey()));
+
+    // A child that doesn't pay enough for both transactions.
+    auto mtx_child_low_fee = CreateValidMempoolTransaction(
+        /*input_transaction=*/tx_parent, /*vout=*/0,
+        /*input_height=*/101, /*input_signing_key=*/parent_key,
+        /*output_destination=*/child_locking_script,
+        /*output_amount=*/coinbase_value - SATOSHI, /*submit=*/false);
+    CTransactionRef tx_child_low_fee = MakeTransactionRef(mtx_child_low_fee);
+    {
+        LOCK(cs_main);
+        const auto result_low_fee = ProcessNewPackage(
+            config, m_node.chainman->ActiveChainstate(), *m_node.mempool,
+            {tx_parent, tx_child_low_fee}, /*test_accept=*/false);
+        BOOST_CHECK(result_low_fee.m_state.IsInvalid());
+        BOOST_CHECK_EQUAL(result_low_fee.m_state.GetResult(),
+                          PackageValidationResult::PCKG_POLICY);
+        BOOST_CHECK_EQUAL(result_low_fee.m_state.GetRejectReason(),
+                          "package-min-relay-fee-not-met");
+        BOOST_CHECK_EQUAL(m_node.mempool->size(), expected_pool_size);
+    }
+
+    // A child paying for its parent gets both accepted.
+    auto mtx_child = CreateValidMempoolTransaction(
+        /*input_transaction=*/tx_parent, /*vout=*/0,
+        /*input_height=*/101, /*input_signing_key=*/parent_key,
+        /*output_destination=*/child_locking_script,
+        /*output_amount=*/coinbase_value - COIN, /*submit=*/false);
+    CTransactionRef tx_child = MakeTransactionRef(mtx_child);
+    {
+        LOCK(cs_main);
+        const auto result_cpfp = ProcessNewPackage(
+            config, m_node.chainman->ActiveChainstate(), *m_node.mempool,
+            {tx_parent, tx_child}, /*test_accept=*/false);
+        expected_pool_size += 2;
+        BOOST_CHECK_MESSAGE(result_cpfp.m_state.IsValid(),
+                            "Package validation unexpectedly failed: "
+                                << result_cpfp.m_state.GetRejectReason());
+        BOOST_CHECK_EQUAL(m_node.mempool->size(), expected_pool_size);
+        BOOST_CHECK(m_node.mempool->exists(tx_parent->GetId()));
+        BOOST_CHECK(m_node.mempool->exists(tx_child->GetId()));
+    }
+
+    // A parent paying a high fee can't pay for a child paying no fee. Mine a
+    // block so the next coinbase is mature.
+    mineBlocks(1);
+    CKey rich_parent_key;
+    rich_parent_key.MakeNewKey(true);
+    CScript rich_parent_locking_script =
+        GetScriptForDestination(PKHash(rich_parent_key.GetPubKey()));
+    auto mtx_rich_parent = CreateValidMempoolTransaction(
+        /*input_transaction=*/m_coinbase_txns[1], /*vout=*/0,
+        /*input_height=*/0, /*input_signing_key=*/coinbaseKey,
+        /*output_destination=*/rich_parent_locking_script,
+        /*output_amount=*/m_coinbase_txns[1]->vout[0].nValue - COIN,
+        /*submit=*/false);
+    CTransactionRef tx_rich_parent = MakeTransactionRef(mtx_rich_parent);
+    auto mtx_free_child = CreateValidMempoolTransaction(
+        /*input_transaction=*/tx_rich_parent, /*vout=*/0,
+        /*input_height=*/101, /*input_signing_key=*/rich_parent_key,
+        /*output_destination=*/child_locking_script,
+        /*output_amount=*/tx_rich_parent->vout[0].nValue, /*submit=*/false);
+    CTransactionRef tx_free_child = MakeTransactionRef(mtx_free_child);
+    {
+        LOCK(cs_main);
+        const auto result_free_child = ProcessNewPackage(
+            config, m_node.chainman->ActiveChainstate(), *m_node.mempool,
+            {tx_rich_parent, tx_free_child}, /*test_accept=*/false);
+        BOOST_CHECK(result_free_child.m_state.IsInvalid());
+        BOOST_CHECK_EQUAL(result_free_child.m_state.GetResult(),
+                          PackageValidationResult::PCKG_POLICY);
+        BOOST_CHECK_EQUAL(result_free_child.m_state.GetRejectReason(),
+                          "package-min-relay-fee-not-met");
+        // The parent is accepted on its own, but the child isn't.
+        expected_pool_size += 1;
+        auto it_rich_parent =
+            result_free_child.m_tx_results.find(tx_rich_parent->GetId());
+        BOOST_CHECK(it_rich_parent != result_free_child.m_tx_results.end());
+        BOOST_CHECK(it_rich_parent->second.m_result_type ==
+                    MempoolAcceptResult::ResultType::VALID);
+        BOOST_CHECK_EQUAL(m_node.mempool->size(), expected_pool_size);
+        BOOST_CHECK(m_node.mempool->exists(tx_rich_parent->GetId()));
+        BOOST_CHECK(!m_node.mempool->exists(tx_free_child->GetId()));
+    }
+}
 BOOST_AUTO_TEST_SUITE_END()
@@ -48,4 +48,60 @@ BOOST_FIXTURE_TEST_CASE(tx_mempool_reject_coinbase, TestChain100Setup) {
     BOOST_CHECK_EQUAL(result.m_state.GetRejectReason(), "bad-tx-coinbase");
     BOOST_CHECK(result.m_state.GetResult() == TxValidationResult::TX_CONSENSUS);
 }
+
+/**
+ * Ensure that the mempool is restored from mempool.dat, both when the tip it
+ * was dumped at is still active and when it changed.
+ */
+BOOST_FIXTURE_TEST_CASE(tx_mempool_dump_load, TestChain100Setup) {
+    const Config &config = GetConfig();
+    CChainState &chainstate = m_node.chainman->ActiveChainstate();
+    CTxMemPool &mempool = *m_node.mempool;
+    const CScript script = CScript() << ToByteVector(coinbaseKey.GetPubKey())
+                                     << OP_CHECKSIG;
+    // Make the second coinbase mature.
+    mineBlocks(1);
+
+    // A parent and its child, which must be loaded after the parent.
+    const CTransactionRef parent =
+        MakeTransactionRef(CreateValidMempoolTransaction(
+            m_coinbase_txns[0], 0, 0, coinbaseKey, script, Amount(49 * COIN)));
+    const CTransactionRef child =
+        MakeTransactionRef(CreateValidMempoolTransaction(
+            parent, 0, 101, coinbaseKey, script, Amount(48 * COIN)));
+    // An unrelated transaction, to be mined after the dump.
+    const CTransactionRef other =
+        MakeTransactionRef(CreateValidMempoolTransaction(
+            m_coinbase_txns[1], 0, 0, coinbaseKey, script, Amount(49 * COIN)));
+    BOOST_CHECK_EQUAL(mempool.size(), 3U);
+    mempool.PrioritiseTransaction(child->GetId(), 1000 * SATOSHI);
+
+    BOOST_CHECK(DumpMempool(mempool, chainstate));
+    // Start from an empty mempool, as after a restart.
+    const auto reset_mempool = [&] {
+        mempool.clear();
+        LOCK(mempool.cs);
+        mempool.ClearPrioritisation(child->GetId());
+    };
+
+    // Same tip
+    reset_mempool();
+    BOOST_CHECK(LoadMempool(config, mempool, chainstate));
+    BOOST_CHECK_EQUAL(mempool.size(), 3U);
+    {
+        LOCK(mempool.cs);
+        BOOST_CHECK_EQUAL(mempool.mapTx.find(child->GetId())->GetModifiedFee(),
+                          mempool.mapTx.find(child->GetId())->GetFee() +
+                              1000 * SATOSHI);
+    }
+
+    // The tip changed, so the scripts are verified again
+    CreateAndProcessBlock({CMutableTransaction(*other)}, script);
+    reset_mempool();
+    BOOST_CHECK(LoadMempool(config, mempool, chainstate));
+    BOOST_CHECK_EQUAL(mempool.size(), 2U);
+    BOOST_CHECK(mempool.exists(parent->GetId()));
+    BOOST_CHECK(mempool.exists(child->GetId()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
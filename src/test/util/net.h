@@ -34,6 +34,20 @@ struct ConnmanTestMsg : public CConnman {
         vNodes.clear();
     }
 
+    /** Register the socket of a test node for the socket handler. */
+    void RegisterTestNodeSocket(CNode &node) {
+        RegisterSocketEvents(WITH_LOCK(node.cs_hSocket, return node.hSocket),
+                             &node);
+    }
+    /** Wait on the sockets with poll or select, even if epoll is available. */
+    void DisableEpoll() {
+        if (m_epoll_fd != -1) {
+            close(m_epoll_fd);
+            m_epoll_fd = -1;
+        }
+    }
+    void SocketHandlerOnce() { SocketHandler(); }
+
     void ProcessMessagesOnce(CNode &node) {
         for (auto interface : m_msgproc) {
             interface->ProcessMessages(*config, &node, flagInterruptMsgProc);
@@ -513,7 +513,10 @@ CTxMemPool::CTxMemPool(int check_ratio) : m_check_ratio(check_ratio) {
     _clear();
 }
 
-CTxMemPool::~CTxMemPool() {}
+CTxMemPool::~CTxMemPool() {
+    const MempoolSnapshot *snapshot = m_snapshot.exchange(nullptr);
+    RCUPtr<const MempoolSnapshot>::acquire(snapshot);
+}
 
 bool CTxMemPool::isSpent(const COutPoint &outpoint) const {
     LOCK(cs);
@@ -569,8 +572,10 @@ void CTxMemPool::addUnchecked(const CTxMemPoolEntry &entry,
     UpdateEntryForAncestors(newit, setAncestors);
 
     nTransactionsUpdated++;
+    ++m_revision;
     totalTxSize += entry.GetTxSize();
     m_total_fee += entry.GetFee();
+    m_fee_histogram.AddTx(newit->GetModifiedFee(), newit->GetTxSize());
 
     vTxHashes.emplace_back(tx.GetHash(), newit);
     newit->vTxHashesIdx = vTxHashes.size() - 1;
@@ -610,11 +615,13 @@ void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason) {
 
     totalTxSize -= it->GetTxSize();
     m_total_fee -= it->GetFee();
+    m_fee_histogram.RemoveTx(it->GetModifiedFee(), it->GetTxSize());
     cachedInnerUsage -= it->DynamicMemoryUsage();
     cachedInnerUsage -= memusage::DynamicUsage(it->GetMemPoolParentsConst()) +
                         memusage::DynamicUsage(it->GetMemPoolChildrenConst());
     mapTx.erase(it);
     nTransactionsUpdated++;
+    ++m_revision;
 }
 
 // Calculates descendants of entry that are not already in setDescendants, and
@@ -694,6 +701,10 @@ void CTxMemPool::removeForReorg(
          it != mapTx.end(); it++) {
         if (check_final_and_mature(it)) {
             txToRemove.insert(it);
+        } else {
+            // The entries that are kept must have up to date lock points,
+            // check them now rather than in another pass over the mempool.
+            assert(TestLockPointValidity(chain, it->GetLockPoints()));
         }
     }
     setEntries setAllRemoves;
@@ -701,10 +712,6 @@ void CTxMemPool::removeForReorg(
         CalculateDescendants(it, setAllRemoves);
     }
     RemoveStaged(setAllRemoves, false, MemPoolRemovalReason::REORG);
-    for (indexed_transaction_set::const_iterator it = mapTx.begin();
-         it != mapTx.end(); it++) {
-        assert(TestLockPointValidity(chain, it->GetLockPoints()));
-    }
 }
 
 void CTxMemPool::removeConflicts(const CTransaction &tx) {
@@ -768,11 +775,13 @@ void CTxMemPool::_clear() {
     vTxHashes.clear();
     totalTxSize = 0;
     m_total_fee = Amount::zero();
+    m_fee_histogram.Clear();
     cachedInnerUsage = 0;
     lastRollingFeeUpdate = GetTime();
     blockSinceLastRollingFeeBump = false;
     rollingMinimumFeeRate = 0;
     ++nTransactionsUpdated;
+    ++m_revision;
 }
 
 void CTxMemPool::clear() {
@@ -914,6 +923,15 @@ void CTxMemPool::check(const CCoinsViewCache &active_coins_tip,
 
     assert(totalTxSize == checkTotal);
     assert(m_total_fee == check_total_fee);
+    uint64_t histogram_count = 0;
+    uint64_t histogram_size = 0;
+    for (const FeeRateHistogram::Bucket &bucket :
+         m_fee_histogram.GetBuckets()) {
+        histogram_count += bucket.count;
+        histogram_size += bucket.size;
+    }
+    assert(histogram_count == mapTx.size());
+    assert(histogram_size == totalTxSize);
     assert(innerUsage == cachedInnerUsage);
 }
 
@@ -1029,6 +1047,13 @@ CFeeRate CTxMemPool::estimateFee() const {
     return std::max(::minRelayTxFee, GetMinFee(maxMempoolSize));
 }
 
+CFeeRate CTxMemPool::estimateFee(unsigned int num_blocks,
+                                 uint64_t block_size) const {
+    LOCK(cs);
+    return std::max(estimateFee(),
+                    m_fee_histogram.GetFeeRateForSize(num_blocks * block_size));
+}
+
 void CTxMemPool::PrioritiseTransaction(const TxId &txid,
                                        const Amount nFeeDelta) {
     {
@@ -1037,7 +1062,9 @@ void CTxMemPool::PrioritiseTransaction(const TxId &txid,
         delta += nFeeDelta;
         txiter it = mapTx.find(txid);
         if (it != mapTx.end()) {
+            m_fee_histogram.RemoveTx(it->GetModifiedFee(), it->GetTxSize());
             mapTx.modify(it, update_fee_delta(delta));
+            m_fee_histogram.AddTx(it->GetModifiedFee(), it->GetTxSize());
             // Now update all ancestors' modified fees with descendants
             setEntries setAncestors;
             uint64_t nNoLimit = std::numeric_limits<uint64_t>::max();
@@ -1058,6 +1085,7 @@ void CTxMemPool::PrioritiseTransaction(const TxId &txid,
                              update_ancestor_state(0, nFeeDelta, 0, 0));
             }
             ++nTransactionsUpdated;
+            ++m_revision;
         }
     }
     LogPrintf("PrioritiseTransaction: %s fee += %s\n", txid.ToString(),
@@ -1164,6 +1192,7 @@ void CTxMemPool::RemoveUnbroadcastTx(const TxId &txid, const bool unchecked) {
     LOCK(cs);
 
     if (m_unbroadcast_txids.erase(txid)) {
+        ++m_revision;
         LogPrint(
             BCLog::MEMPOOL, "Removed %i from set of unbroadcast txns%s\n",
             txid.GetHex(),
@@ -1266,6 +1295,64 @@ CFeeRate CTxMemPool::GetMinFee(size_t sizelimit) const {
     return CFeeRate(int64_t(ceill(rollingMinimumFeeRate)) * SATOSHI);
 }
 
+/**
+ * Maximum age of a mempool snapshot. GetMinFee() only decays the rolling
+ * minimum fee every 10 seconds, so the snapshot is refreshed just as often.
+ */
+static constexpr std::chrono::seconds MEMPOOL_SNAPSHOT_MAX_AGE{10};
+
+RCUPtr<const MempoolSnapshot> CTxMemPool::GetSnapshot() const {
+    const auto isUpToDate = [&](const MempoolSnapshot *snapshot) {
+        return snapshot != nullptr && snapshot->revision == m_revision &&
+               snapshot->time + MEMPOOL_SNAPSHOT_MAX_AGE >
+                   GetTime<std::chrono::seconds>();
+    };
+
+    {
+        RCULock lock;
+        const MempoolSnapshot *snapshot = m_snapshot.load();
+        if (isUpToDate(snapshot)) {
+            return RCUPtr<const MempoolSnapshot>::copy(snapshot);
+        }
+    }
+
+    LOCK(cs);
+
+    // Another reader might have refreshed the snapshot while we were waiting
+    // for the lock.
+    {
+        RCULock lock;
+        const MempoolSnapshot *snapshot = m_snapshot.load();
+        if (isUpToDate(snapshot)) {
+            return RCUPtr<const MempoolSnapshot>::copy(snapshot);
+        }
+    }
+
+    auto snapshot = RCUPtr<MempoolSnapshot>::make();
+    snapshot->revision = m_revision;
+    snapshot->time = GetTime<std::chrono::seconds>();
+    snapshot->loaded = m_is_loaded;
+    snapshot->sequence = m_sequence_number;
+    snapshot->txids.reserve(mapTx.size());
+    for (const auto &it : GetSortedDepthAndScore()) {
+        snapshot->txids.push_back(it->GetTx().GetId());
+    }
+    snapshot->total_tx_size = totalTxSize;
+    snapshot->total_fee = m_total_fee;
+    snapshot->dynamic_usage = DynamicMemoryUsage();
+    snapshot->min_fee = GetMinFee(
+        gArgs.GetIntArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000);
+    snapshot->unbroadcast_count = m_unbroadcast_txids.size();
+    snapshot->fee_histogram = m_fee_histogram;
+
+    RCUPtr<const MempoolSnapshot> published(snapshot);
+    const MempoolSnapshot *previous =
+        m_snapshot.exchange(RCUPtr<const MempoolSnapshot>(published).release());
+    RCUPtr<const MempoolSnapshot>::acquire(previous);
+
+    return published;
+}
+
 void CTxMemPool::trackPackageRemoved(const CFeeRate &rate) {
     AssertLockHeld(cs);
     if ((rate.GetFeePerK() / SATOSHI) > rollingMinimumFeeRate) {
@@ -1379,6 +1466,7 @@ bool CTxMemPool::IsLoaded() const {
 void CTxMemPool::SetIsLoaded(bool loaded) {
     LOCK(cs);
     m_is_loaded = loaded;
+    ++m_revision;
 }
 
 /** Maximum bytes for transactions to store for processing during reorg */
@@ -1492,14 +1580,31 @@ void DisconnectedBlockTransactions::updateMempoolForReorg(
     // Iterate disconnectpool in reverse, so that we add transactions back to
     // the mempool starting with the earliest transaction that had been
     // previously seen in a block.
+    std::vector<CTransactionRef> txsToAdd;
+    if (fAddToMempool) {
+        txsToAdd.reserve(queuedTx.size());
+        for (const CTransactionRef &tx :
+             reverse_iterate(queuedTx.get<insertion_order>())) {
+            if (!tx->IsCoinBase()) {
+                txsToAdd.push_back(tx);
+            }
+        }
+    }
+
+    // Validate all the transactions in a single batch. A transaction that
+    // fails can only have descendants in the batch, which fail as well for
+    // missing inputs.
+    const std::vector<MempoolAcceptResult> results =
+        AcceptReorgTransactionsToMemoryPool(config, active_chainstate,
+                                            txsToAdd, GetTime());
+
+    auto resultIt = results.begin();
     for (const CTransactionRef &tx :
          reverse_iterate(queuedTx.get<insertion_order>())) {
         // ignore validation errors in resurrected transactions
         if (!fAddToMempool || tx->IsCoinBase() ||
-            AcceptToMemoryPool(config, active_chainstate, tx, GetTime(),
-                               /*bypass_limits=*/true,
-                               /*test_accept=*/false)
-                    .m_result_type != MempoolAcceptResult::ResultType::VALID) {
+            (resultIt++)->m_result_type !=
+                MempoolAcceptResult::ResultType::VALID) {
             // If the transaction doesn't make it in to the mempool, remove any
             // transactions that depend on it (which would now be orphans).
             pool.removeRecursive(*tx, MemPoolRemovalReason::REORG);
@@ -1507,6 +1612,7 @@ void DisconnectedBlockTransactions::updateMempoolForReorg(
             txidsUpdate.push_back(tx->GetId());
         }
     }
+    assert(resultIt == results.end());
 
     queuedTx.clear();
 
@@ -1517,18 +1623,27 @@ void DisconnectedBlockTransactions::updateMempoolForReorg(
     // disconnectpool that were added back and cleans up the mempool state.
     pool.UpdateTransactionsFromBlock(txidsUpdate);
 
+    // The transactions that were just added back have been checked for
+    // finality, sequence locks and coinbase maturity against the current tip
+    // already, so there is no need to check them again.
+    const std::unordered_set<TxId, SaltedTxIdHasher> txidsAdded(
+        txidsUpdate.begin(), txidsUpdate.end());
+    CCoinsViewMemPool view_mempool(&active_chainstate.CoinsTip(), pool);
+
     const auto check_final_and_mature =
         [&pool, &active_chainstate, flags = STANDARD_LOCKTIME_VERIFY_FLAGS,
-         &config](CTxMemPool::txiter it) EXCLUSIVE_LOCKS_REQUIRED(pool.cs,
-                                                                  ::cs_main) {
+         &config, &txidsAdded, &view_mempool](CTxMemPool::txiter it)
+            EXCLUSIVE_LOCKS_REQUIRED(pool.cs, ::cs_main) {
             bool should_remove = false;
             AssertLockHeld(pool.cs);
             AssertLockHeld(::cs_main);
             const CTransaction &tx = it->GetTx();
+            if (txidsAdded.count(tx.GetId())) {
+                return should_remove;
+            }
             LockPoints lp = it->GetLockPoints();
             const bool validLP{
                 TestLockPointValidity(active_chainstate.m_chain, lp)};
-            CCoinsViewMemPool view_mempool(&active_chainstate.CoinsTip(), pool);
 
             TxValidationState state;
             if (!ContextualCheckTransactionForCurrentBlock(
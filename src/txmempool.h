@@ -10,8 +10,10 @@
 #include <consensus/amount.h>
 #include <core_memusage.h>
 #include <indirectmap.h>
+#include <policy/fees.h>
 #include <policy/packages.h>
 #include <primitives/transaction.h>
+#include <rcu.h>
 #include <sync.h>
 #include <util/epochguard.h>
 #include <util/hasher.h>
@@ -22,6 +24,7 @@
 #include <boost/multi_index_container.hpp>
 
 #include <atomic>
+#include <chrono>
 #include <map>
 #include <optional>
 #include <set>
@@ -375,6 +378,34 @@ enum class MemPoolRemovalReason {
     REPLACED
 };
 
+/**
+ * Immutable view of the mempool content and statistics. It is published by
+ * CTxMemPool through RCU, so the readers polling the mempool (RPC, REST) don't
+ * contend with transaction acceptance on the mempool lock.
+ */
+class MempoolSnapshot {
+public:
+    //! Revision of the mempool this snapshot was built from.
+    uint64_t revision{0};
+    //! Time at which the snapshot was built.
+    std::chrono::seconds time{0};
+
+    bool loaded{false};
+    uint64_t sequence{0};
+    //! Transaction ids, sorted by depth and then by descendant score.
+    std::vector<TxId> txids;
+    uint64_t total_tx_size{0};
+    Amount total_fee{Amount::zero()};
+    size_t dynamic_usage{0};
+    //! Rolling minimum fee rate for the -maxmempool size limit.
+    CFeeRate min_fee;
+    size_t unbroadcast_count{0};
+    //! Transactions by modified fee rate.
+    FeeRateHistogram fee_histogram;
+
+    IMPLEMENT_RCU_REFCOUNT(uint64_t);
+};
+
 /**
  * CTxMemPool stores valid-according-to-the-current-best-chain transactions that
  * may be included in the next block.
@@ -462,6 +493,8 @@ private:
     //! sum of dynamic memory usage of all the map elements (NOT the maps
     //! themselves)
     uint64_t cachedInnerUsage GUARDED_BY(cs);
+    //! all mempool txs by modified fee rate
+    FeeRateHistogram m_fee_histogram GUARDED_BY(cs);
 
     mutable int64_t lastRollingFeeUpdate GUARDED_BY(cs);
     mutable bool blockSinceLastRollingFeeBump GUARDED_BY(cs);
@@ -478,6 +511,12 @@ private:
 
     bool m_is_loaded GUARDED_BY(cs){false};
 
+    //! Incremented every time the state exposed by MempoolSnapshot changes.
+    //! Only modified with cs held, but read without it.
+    std::atomic<uint64_t> m_revision{0};
+    //! The latest snapshot, owned by the mempool. See GetSnapshot().
+    mutable std::atomic<const MempoolSnapshot *> m_snapshot{nullptr};
+
 public:
     // public only for testing
     static const int ROLLING_FEE_HALFLIFE = 60 * 60 * 12;
@@ -753,6 +792,14 @@ public:
      */
     CFeeRate GetMinFee(size_t sizelimit) const;
 
+    /**
+     * Get an immutable view of the mempool. The mempool lock is only taken
+     * when the mempool changed since the latest snapshot was built, or when
+     * that snapshot is too old for its minimum fee to still be accurate. The
+     * same snapshot is shared by all the readers in the meantime.
+     */
+    RCUPtr<const MempoolSnapshot> GetSnapshot() const;
+
     /**
      * Remove transactions from the mempool until its dynamic size is <=
      * sizelimit. pvNoSpendsRemaining, if set, will be populated with the list
@@ -819,6 +866,13 @@ public:
     std::vector<TxMempoolInfo> infoAll() const;
 
     CFeeRate estimateFee() const;
+    /**
+     * Estimate the fee rate needed for a transaction to be mined within
+     * num_blocks blocks of block_size bytes, assuming blocks are filled by
+     * decreasing fee rate from the current mempool content. The result is
+     * never below estimateFee().
+     */
+    CFeeRate estimateFee(unsigned int num_blocks, uint64_t block_size) const;
 
     size_t DynamicMemoryUsage() const;
 
@@ -827,8 +881,8 @@ public:
         LOCK(cs);
         // Sanity check the transaction is in the mempool & insert into
         // unbroadcast set.
-        if (exists(txid)) {
-            m_unbroadcast_txids.insert(txid);
+        if (exists(txid) && m_unbroadcast_txids.insert(txid).second) {
+            ++m_revision;
         }
     }
 
@@ -307,6 +307,12 @@ public:
          * enforced at the end to ensure the package is not partially submitted.
          */
         const bool m_package_submission;
+        /**
+         * When true, the minimum relay and mempool minimum fee rates are
+         * enforced on the package as a whole rather than on each individual
+         * transaction, so that a child can pay for its low fee parents.
+         */
+        const bool m_package_feerates;
 
         /** Parameters for single transaction mempool validation. */
         static ATMPArgs SingleAccept(const Config &config, int64_t accept_time,
@@ -318,7 +324,8 @@ public:
                             bypass_limits,
                             coins_to_uncache,
                             test_accept,
-                            /*m_package_submission=*/false};
+                            /*m_package_submission=*/false,
+                            /*m_package_feerates=*/false};
         }
 
         /**
@@ -332,7 +339,24 @@ public:
                             /*m_bypass_limits=*/false, coins_to_uncache,
                             /*m_test_accept=*/true,
                             // not submitting to mempool
-                            /*m_package_submission=*/false};
+                            /*m_package_submission=*/false,
+                            /*m_package_feerates=*/false};
+        }
+
+        /**
+         * Parameters for the individual submission of a transaction within a
+         * child-with-unconfirmed-parents package. Transactions that can pay
+         * for themselves are accepted on their own, so they cannot be used to
+         * pay for other transactions in the package.
+         */
+        static ATMPArgs SingleInPackageAccept(const ATMPArgs &package_args) {
+            return ATMPArgs{package_args.m_config,
+                            package_args.m_accept_time,
+                            /*m_bypass_limits=*/false,
+                            package_args.m_coins_to_uncache,
+                            /*m_test_accept=*/false,
+                            /*m_package_submission=*/false,
+                            /*m_package_feerates=*/false};
         }
 
         /** Parameters for child-with-unconfirmed-parents package validation. */
@@ -344,7 +368,8 @@ public:
                             /*m_bypass_limits=*/false,
                             coins_to_uncache,
                             /*m_test_accept=*/false,
-                            /*m_package_submission=*/true};
+                            /*m_package_submission=*/true,
+                            /*m_package_feerates=*/true};
         }
         // No default ctor to avoid exposing details to clients and allowing the
         // possibility of mixing up the order of the arguments. Use static
@@ -441,6 +466,14 @@ private:
                               PackageValidationState &package_state)
         EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_pool.cs);
 
+    // Enforce the minimum relay and mempool minimum fee rates against the
+    // aggregated fees and sizes of all the transactions in the package. Only
+    // used when individual transactions were exempted from these checks in
+    // PreChecks().
+    bool CheckPackageFeeRate(const std::vector<Workspace> &workspaces,
+                             PackageValidationState &package_state)
+        EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_pool.cs);
+
     // Re-run the script checks, using consensus flags, and try to cache the
     // result in the scriptcache. This should be done after
     // PolicyScriptChecks(). This requires that all inputs either be in our
@@ -637,8 +670,11 @@ bool MemPoolAccept::PreChecks(ATMPArgs &args, Workspace &ws) {
     // blocks.
     // Do not change this to use virtualsize without coordinating a network
     // policy upgrade.
-    if (!bypass_limits && ws.m_modified_fees < minRelayTxFee.GetFee(nSize)) {
-        return state.Invalid(TxValidationResult::TX_MEMPOOL_POLICY,
+    // When package feerates are in use, this is checked against the whole
+    // package in AcceptMultipleTransactions() instead.
+    if (!bypass_limits && !args.m_package_feerates &&
+        ws.m_modified_fees < minRelayTxFee.GetFee(nSize)) {
+        return state.Invalid(TxValidationResult::TX_PACKAGE_RECONSIDERABLE,
                              "min relay fee not met",
                              strprintf("%d < %d", ws.m_modified_fees,
                                        ::minRelayTxFee.GetFee(nSize)));
@@ -666,10 +702,12 @@ bool MemPoolAccept::PreChecks(ATMPArgs &args, Workspace &ws) {
                 gArgs.GetIntArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) *
                 1000000)
             .GetFee(ws.m_vsize);
-    if (!bypass_limits && mempoolRejectFee > Amount::zero() &&
+    if (!bypass_limits && !args.m_package_feerates &&
+        mempoolRejectFee > Amount::zero() &&
         ws.m_modified_fees < mempoolRejectFee) {
         return state.Invalid(
-            TxValidationResult::TX_MEMPOOL_POLICY, "mempool min fee not met",
+            TxValidationResult::TX_PACKAGE_RECONSIDERABLE,
+            "mempool min fee not met",
             strprintf("%d < %d", ws.m_modified_fees, mempoolRejectFee));
     }
 
@@ -708,6 +746,44 @@ bool MemPoolAccept::PackageMempoolChecks(
     return true;
 }
 
+bool MemPoolAccept::CheckPackageFeeRate(
+    const std::vector<Workspace> &workspaces,
+    PackageValidationState &package_state) {
+    AssertLockHeld(cs_main);
+    AssertLockHeld(m_pool.cs);
+
+    Amount package_fees = Amount::zero();
+    size_t package_size = 0;
+    int64_t package_vsize = 0;
+    for (const Workspace &ws : workspaces) {
+        package_fees += ws.m_modified_fees;
+        package_size += ws.m_ptx->GetTotalSize();
+        package_vsize += ws.m_vsize;
+    }
+
+    if (package_fees < ::minRelayTxFee.GetFee(package_size)) {
+        return package_state.Invalid(
+            PackageValidationResult::PCKG_POLICY,
+            "package-min-relay-fee-not-met",
+            strprintf("%d < %d", package_fees,
+                      ::minRelayTxFee.GetFee(package_size)));
+    }
+
+    const Amount mempoolRejectFee =
+        m_pool
+            .GetMinFee(
+                gArgs.GetIntArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) *
+                1000000)
+            .GetFee(package_vsize);
+    if (mempoolRejectFee > Amount::zero() && package_fees < mempoolRejectFee) {
+        return package_state.Invalid(
+            PackageValidationResult::PCKG_POLICY,
+            "package-mempool-min-fee-not-met",
+            strprintf("%d < %d", package_fees, mempoolRejectFee));
+    }
+    return true;
+}
+
 bool MemPoolAccept::ConsensusScriptChecks(const ATMPArgs &args, Workspace &ws) {
     const CTransaction &tx = *ws.m_ptx;
     const TxId &txid = tx.GetId();
@@ -948,6 +1024,13 @@ PackageMempoolAcceptResult MemPoolAccept::AcceptMultipleTransactions(
         }
     }
 
+    // Evaluate the fee rate of the package as a whole, so that a high fee
+    // child can pay for low fee parents (CPFP).
+    if (args.m_package_feerates &&
+        !CheckPackageFeeRate(workspaces, package_state)) {
+        return PackageMempoolAcceptResult(package_state, std::move(results));
+    }
+
     // Apply package mempool ancestor/descendant limits. Skip if there is only
     // one transaction, because it's unnecessary. Also, CPFP carve out can
     // increase the limit for individual transactions, but this exemption is
@@ -1044,7 +1127,12 @@ PackageMempoolAcceptResult MemPoolAccept::AcceptPackage(const Package &package,
     // that could be a censorship vector).  Filter the transactions that are
     // already in mempool and add their information to results, since we already
     // have them.
-    std::vector<CTransactionRef> txns_new;
+    // The other transactions are submitted individually first, in topological
+    // order, so that only the ones which are below the required fee rate on
+    // their own get their fees aggregated. This prevents a high fee parent
+    // from paying for a low fee child.
+    std::vector<CTransactionRef> txns_package_eval;
+    ATMPArgs single_args = ATMPArgs::SingleInPackageAccept(args);
     for (const auto &tx : package) {
         const auto &txid = tx->GetId();
         // An already confirmed tx is treated as one not in mempool, because all
@@ -1056,19 +1144,40 @@ PackageMempoolAcceptResult MemPoolAccept::AcceptPackage(const Package &package,
             results.emplace(
                 txid, MempoolAcceptResult::MempoolTx(iter.value()->GetTxSize(),
                                                      iter.value()->GetFee()));
-        } else {
-            // Transaction does not already exist in the mempool.
-            txns_new.push_back(tx);
+            continue;
+        }
+
+        // Transaction does not already exist in the mempool.
+        const auto single_res = AcceptSingleTransaction(tx, single_args);
+        if (single_res.m_result_type ==
+            MempoolAcceptResult::ResultType::VALID) {
+            results.emplace(txid, single_res);
+            continue;
+        }
+
+        const TxValidationResult single_result = single_res.m_state.GetResult();
+        if (single_result != TxValidationResult::TX_PACKAGE_RECONSIDERABLE &&
+            single_result != TxValidationResult::TX_MISSING_INPUTS) {
+            // The transaction is invalid for a reason that no other
+            // transaction in the package can fix, there is no point in
+            // evaluating the package any further.
+            package_state.Invalid(PackageValidationResult::PCKG_TX,
+                                  "transaction failed");
+            results.emplace(txid, single_res);
+            return PackageMempoolAcceptResult(package_state,
+                                              std::move(results));
         }
+        txns_package_eval.push_back(tx);
     }
 
     // Nothing to do if the entire package has already been submitted.
-    if (txns_new.empty()) {
+    if (txns_package_eval.empty()) {
         return PackageMempoolAcceptResult(package_state, std::move(results));
     }
-    // Validate the (deduplicated) transactions as a package.
-    auto submission_result = AcceptMultipleTransactions(txns_new, args);
-    // Include already-in-mempool transaction results in the final result.
+    // Validate the remaining transactions as a package.
+    auto submission_result = AcceptMultipleTransactions(txns_package_eval, args);
+    // Include already-in-mempool and individually accepted transaction results
+    // in the final result.
     for (const auto &[txid, mempoolaccept_res] : results) {
         submission_result.m_tx_results.emplace(txid, mempoolaccept_res);
     }
@@ -1109,6 +1218,43 @@ MempoolAcceptResult AcceptToMemoryPool(const Config &config,
     return result;
 }
 
+std::vector<MempoolAcceptResult>
+AcceptReorgTransactionsToMemoryPool(const Config &config,
+                                    CChainState &active_chainstate,
+                                    const std::vector<CTransactionRef> &txs,
+                                    int64_t accept_time) {
+    AssertLockHeld(cs_main);
+    assert(active_chainstate.GetMempool() != nullptr);
+    CTxMemPool &pool{*active_chainstate.GetMempool()};
+
+    std::vector<MempoolAcceptResult> results;
+    results.reserve(txs.size());
+
+    // All the transactions are validated against the same tip, so they can
+    // share the MemPoolAccept instance and its coins view: the coins fetched
+    // for a transaction remain cached for its descendants in the batch.
+    MemPoolAccept accept(pool, active_chainstate);
+    std::vector<COutPoint> coins_to_uncache;
+    for (const CTransactionRef &tx : txs) {
+        coins_to_uncache.clear();
+        auto args = MemPoolAccept::ATMPArgs::SingleAccept(
+            config, accept_time, /*bypass_limits=*/true, coins_to_uncache,
+            /*test_accept=*/false);
+        results.push_back(accept.AcceptSingleTransaction(tx, args));
+        if (results.back().m_result_type !=
+            MempoolAcceptResult::ResultType::VALID) {
+            for (const COutPoint &outpoint : coins_to_uncache) {
+                active_chainstate.CoinsTip().Uncache(outpoint);
+            }
+        }
+    }
+
+    // Only check the coins cache size limits once for the whole batch.
+    BlockValidationState stateDummy;
+    active_chainstate.FlushStateToDisk(stateDummy, FlushStateMode::PERIODIC);
+    return results;
+}
+
 PackageMempoolAcceptResult
 ProcessNewPackage(const Config &config, CChainState &active_chainstate,
                   CTxMemPool &pool, const Package &package, bool test_accept) {
@@ -5495,7 +5641,82 @@ bool CChainState::ResizeCoinsCaches(size_t coinstip_size, size_t coinsdb_size) {
     return ret;
 }
 
-static const uint64_t MEMPOOL_DUMP_VERSION = 1;
+static const uint64_t MEMPOOL_DUMP_VERSION_NO_TIP = 1;
+static const uint64_t MEMPOOL_DUMP_VERSION = 2;
+//! Number of mempool.dat transactions accepted per cs_main lock.
+static constexpr size_t MEMPOOL_LOAD_BATCH_SIZE{1000};
+
+namespace {
+struct MempoolDumpEntry {
+    CTransactionRef tx;
+    int64_t time;
+    int64_t fee_delta;
+    //! Sigchecks of the transaction against the tip the mempool was dumped
+    //! at. Only available from MEMPOOL_DUMP_VERSION.
+    uint32_t sig_checks{0};
+};
+} // namespace
+
+/**
+ * Avoid executing the scripts of a batch of mempool.dat transactions serially
+ * when they are accepted to the mempool.
+ *
+ * When the mempool was dumped at the current tip with the same script flags,
+ * all the transactions were already validated against them: their script
+ * execution results are added to the script cache. Otherwise, the scripts are
+ * run in parallel on the script check threads beforehand, which fills the
+ * signature cache. Failures are ignored here and reported by
+ * AcceptToMemoryPool.
+ */
+static void PrepareMempoolLoadScriptChecks(
+    CChainState &active_chainstate, const std::vector<MempoolDumpEntry> &batch,
+    const BlockHash &dump_tip, uint32_t dump_script_flags)
+    EXCLUSIVE_LOCKS_REQUIRED(cs_main) {
+    const CBlockIndex *tip = active_chainstate.m_chain.Tip();
+    const uint32_t next_block_script_flags = GetNextBlockScriptFlags(
+        active_chainstate.m_params.GetConsensus(), tip);
+    const uint32_t standard_script_flags =
+        next_block_script_flags | STANDARD_SCRIPT_VERIFY_FLAGS;
+
+    if (tip && tip->GetBlockHash() == dump_tip &&
+        next_block_script_flags == dump_script_flags) {
+        for (const MempoolDumpEntry &entry : batch) {
+            AddKeyInScriptCache(
+                ScriptCacheKey(*entry.tx, standard_script_flags),
+                entry.sig_checks);
+            AddKeyInScriptCache(
+                ScriptCacheKey(*entry.tx, next_block_script_flags),
+                entry.sig_checks);
+        }
+        return;
+    }
+
+    CTxMemPool &pool = *active_chainstate.GetMempool();
+    LOCK(pool.cs);
+    CCoinsViewMemPool view_mempool(&active_chainstate.CoinsTip(), pool);
+    CCoinsViewCache view(&view_mempool);
+
+    std::vector<CScriptCheck> checks;
+    for (const MempoolDumpEntry &entry : batch) {
+        const CTransaction &tx = *entry.tx;
+        if (tx.IsCoinBase() || !view.HaveInputs(tx)) {
+            continue;
+        }
+
+        const PrecomputedTransactionData txdata(tx);
+        for (size_t i = 0; i < tx.vin.size(); i++) {
+            checks.emplace_back(view.AccessCoin(tx.vin[i].prevout).GetTxOut(),
+                                tx, i, standard_script_flags,
+                                /*cacheIn=*/true, txdata);
+        }
+        // Make the outputs available to the children later in the batch.
+        AddCoins(view, tx, MEMPOOL_HEIGHT, /*check_for_overwrite=*/true);
+    }
+
+    CCheckQueueControl<CScriptCheck> control(&scriptcheckqueue);
+    control.Add(checks);
+    control.Wait();
+}
 
 bool LoadMempool(const Config &config, CTxMemPool &pool,
                  CChainState &active_chainstate) {
@@ -5520,30 +5741,53 @@ bool LoadMempool(const Config &config, CTxMemPool &pool,
     try {
         uint64_t version;
         file >> version;
-        if (version != MEMPOOL_DUMP_VERSION) {
+        if (version != MEMPOOL_DUMP_VERSION &&
+            version != MEMPOOL_DUMP_VERSION_NO_TIP) {
             return false;
         }
 
+        BlockHash dump_tip;
+        uint32_t dump_script_flags = 0;
+        if (version == MEMPOOL_DUMP_VERSION) {
+            file >> dump_tip;
+            file >> dump_script_flags;
+        }
+
         uint64_t num;
         file >> num;
-        while (num--) {
-            CTransactionRef tx;
-            int64_t nTime;
-            int64_t nFeeDelta;
-            file >> tx;
-            file >> nTime;
-            file >> nFeeDelta;
-
-            Amount amountdelta = nFeeDelta * SATOSHI;
-            if (amountdelta != Amount::zero()) {
-                pool.PrioritiseTransaction(tx->GetId(), amountdelta);
+        std::vector<MempoolDumpEntry> batch;
+        while (num) {
+            // The transactions are dumped in topological order, so the parents
+            // are always accepted before their children.
+            batch.clear();
+            while (num && batch.size() < MEMPOOL_LOAD_BATCH_SIZE) {
+                num--;
+                MempoolDumpEntry entry;
+                file >> entry.tx;
+                file >> entry.time;
+                file >> entry.fee_delta;
+                if (version == MEMPOOL_DUMP_VERSION) {
+                    file >> entry.sig_checks;
+                }
+
+                Amount amountdelta = entry.fee_delta * SATOSHI;
+                if (amountdelta != Amount::zero()) {
+                    pool.PrioritiseTransaction(entry.tx->GetId(), amountdelta);
+                }
+                if (entry.time > nNow - nExpiryTimeout) {
+                    batch.push_back(std::move(entry));
+                } else {
+                    ++expired;
+                }
             }
-            if (nTime > nNow - nExpiryTimeout) {
-                LOCK(cs_main);
-                const auto &accepted =
-                    AcceptToMemoryPool(config, active_chainstate, tx, nTime,
-                                       /*bypass_limits=*/false,
-                                       /*test_accept=*/false);
+
+            LOCK(cs_main);
+            PrepareMempoolLoadScriptChecks(active_chainstate, batch, dump_tip,
+                                           dump_script_flags);
+            for (const MempoolDumpEntry &entry : batch) {
+                const auto &accepted = AcceptToMemoryPool(
+                    config, active_chainstate, entry.tx, entry.time,
+                    /*bypass_limits=*/false, /*test_accept=*/false);
                 if (accepted.m_result_type ==
                     MempoolAcceptResult::ResultType::VALID) {
                     ++count;
@@ -5552,18 +5796,16 @@ bool LoadMempool(const Config &config, CTxMemPool &pool,
                     // wallet(s) having loaded it while we were processing
                     // mempool transactions; consider these as valid, instead of
                     // failed, but mark them as 'already there'
-                    if (pool.exists(tx->GetId())) {
+                    if (pool.exists(entry.tx->GetId())) {
                         ++already_there;
                     } else {
                         ++failed;
                     }
                 }
-            } else {
-                ++expired;
-            }
 
-            if (ShutdownRequested()) {
-                return false;
+                if (ShutdownRequested()) {
+                    return false;
+                }
             }
         }
         std::map<TxId, Amount> mapDeltas;
@@ -5597,23 +5839,42 @@ bool LoadMempool(const Config &config, CTxMemPool &pool,
     return true;
 }
 
-bool DumpMempool(const CTxMemPool &pool) {
+bool DumpMempool(const CTxMemPool &pool, CChainState &active_chainstate) {
     int64_t start = GetTimeMicros();
 
     std::map<uint256, Amount> mapDeltas;
     std::vector<TxMempoolInfo> vinfo;
+    std::vector<uint32_t> sig_checks;
     std::set<TxId> unbroadcast_txids;
+    BlockHash tip_hash;
+    uint32_t script_flags = 0;
 
     static Mutex dump_mutex;
     LOCK(dump_mutex);
 
     {
-        LOCK(pool.cs);
+        // Hold cs_main so the transactions are consistent with the tip they
+        // are recorded against.
+        LOCK2(::cs_main, pool.cs);
+        const CBlockIndex *tip = active_chainstate.m_chain.Tip();
+        if (tip) {
+            tip_hash = tip->GetBlockHash();
+            script_flags = GetNextBlockScriptFlags(
+                active_chainstate.m_params.GetConsensus(), tip);
+        }
+
         for (const auto &i : pool.mapDeltas) {
             mapDeltas[i.first] = i.second;
         }
 
+        // Sorted by ancestor count, so parents are dumped before children.
         vinfo = pool.infoAll();
+        sig_checks.reserve(vinfo.size());
+        for (const auto &i : vinfo) {
+            // The entry sigop count holds the transaction sigchecks.
+            sig_checks.push_back(
+                pool.mapTx.find(i.tx->GetId())->GetSigOpCount());
+        }
         unbroadcast_txids = pool.GetUnbroadcastTxs();
     }
 
@@ -5630,13 +5891,16 @@ bool DumpMempool(const CTxMemPool &pool) {
 
         uint64_t version = MEMPOOL_DUMP_VERSION;
         file << version;
+        file << tip_hash;
+        file << script_flags;
 
         file << uint64_t(vinfo.size());
-        for (const auto &i : vinfo) {
-            file << *(i.tx);
-            file << int64_t(count_seconds(i.m_time));
-            file << i.nFeeDelta;
-            mapDeltas.erase(i.tx->GetId());
+        for (size_t i = 0; i < vinfo.size(); i++) {
+            file << *(vinfo[i].tx);
+            file << int64_t(count_seconds(vinfo[i].m_time));
+            file << vinfo[i].nFeeDelta;
+            file << sig_checks[i];
+            mapDeltas.erase(vinfo[i].tx->GetId());
         }
 
         file << mapDeltas;
@@ -351,6 +351,26 @@ AcceptToMemoryPool(const Config &config, CChainState &active_chainstate,
                    bool bypass_limits, bool test_accept = false)
     EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
+/**
+ * Try to add the transactions from disconnected blocks back to the mempool
+ * after a reorg. This is equivalent to calling AcceptToMemoryPool() with
+ * bypass_limits set for each transaction in order, but the validation state is
+ * shared across the batch and the coins cache is only flushed once.
+ *
+ * @param[in]  txs          The transactions to add back, in topological order.
+ *                          Must not contain any coinbase transaction.
+ * @param[in]  accept_time  The timestamp for adding the transactions to the
+ *                          mempool.
+ *
+ * @returns a MempoolAcceptResult for each transaction, in the same order.
+ */
+std::vector<MempoolAcceptResult>
+AcceptReorgTransactionsToMemoryPool(const Config &config,
+                                    CChainState &active_chainstate,
+                                    const std::vector<CTransactionRef> &txs,
+                                    int64_t accept_time)
+    EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+
 /**
  * Validate (and maybe submit) a package to the mempool.
  * See doc/policy/packages.md for full detailson package validation rules.
@@ -1313,10 +1333,16 @@ public:
     }
 };
 
-/** Dump the mempool to disk. */
-bool DumpMempool(const CTxMemPool &pool);
+/**
+ * Dump the mempool to disk, along with the tip and script flags its
+ * transactions were validated against.
+ */
+bool DumpMempool(const CTxMemPool &pool, CChainState &active_chainstate);
 
-/** Load the mempool from disk. */
+/**
+ * Load the mempool from disk. If it was dumped at the current tip, the script
+ * checks of its transactions are not repeated.
+ */
 bool LoadMempool(const Config &config, CTxMemPool &pool,
                  CChainState &active_chainstate);
 
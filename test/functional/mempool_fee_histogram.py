@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 The Bitcoin developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""Test the getfeehistogram RPC and the estimatefee nblocks argument."""
+
+from decimal import Decimal
+
+from test_framework.test_framework import BitcoinTestFramework
+from test_framework.util import assert_equal, assert_raises_rpc_error
+from test_framework.wallet import MiniWallet
+
+NUM_TXS = 20
+# MiniWallet transactions are padded to 100 bytes, and 1000 bytes are kept for
+# the header and coinbase, so 10 of them fill a block for the fee estimation.
+BLOCK_MAX_SIZE = 2000
+
+
+class MempoolFeeHistogramTest(BitcoinTestFramework):
+    def set_test_params(self):
+        self.num_nodes = 1
+        self.setup_clean_chain = True
+        self.extra_args = [[f"-blockmaxsize={BLOCK_MAX_SIZE}"]]
+
+    def run_test(self):
+        node = self.nodes[0]
+        wallet = MiniWallet(node)
+        self.generate(wallet, NUM_TXS)
+        self.generate(node, 100)
+
+        min_fee = node.estimatefee()
+        assert_equal(min_fee, Decimal('10.00'))
+        assert_equal(node.getfeehistogram(), [])
+        assert_equal(node.estimatefee(1), min_fee)
+
+        self.log.info("Fill the mempool with 2 blocks worth of transactions")
+        txids = []
+        for i in range(NUM_TXS):
+            tx = wallet.send_self_transfer(
+                from_node=node, fee_rate=Decimal(100 * (i + 1)))
+            txids.append(tx['txid'])
+
+        histogram = node.getfeehistogram()
+        assert_equal(sum(bucket['count'] for bucket in histogram), NUM_TXS)
+        assert_equal(histogram[-1]['cumulativesize'],
+                     node.getmempoolinfo()['bytes'])
+        feerates = [bucket['feerate'] for bucket in histogram]
+        assert_equal(feerates, sorted(feerates, reverse=True))
+
+        self.log.info("Check estimatefee with a number of blocks")
+        # Only the 10 transactions paying more than 1000 XEC/kB fit in the
+        # next block.
+        estimate = node.estimatefee(1)
+        assert Decimal('1000.00') < estimate < Decimal('2000.00')
+        # Everything fits in 2 blocks, so only the minimum fee is required.
+        assert_equal(node.estimatefee(2), min_fee)
+        assert_equal(node.estimatefee(nblocks=1), estimate)
+
+        assert_raises_rpc_error(-8, "Invalid nblocks", node.estimatefee, 0)
+        assert_raises_rpc_error(-8, "Invalid nblocks", node.estimatefee, 1009)
+
+        self.log.info("Check that prioritisetransaction moves transactions")
+        node.prioritisetransaction(txid=txids[0], fee_delta=1000000)
+        assert_equal(node.getfeehistogram()[0]['count'], 1)
+        assert node.estimatefee(1) > estimate
+
+        self.log.info("Check that mined transactions leave the histogram")
+        # Blocks that small can't fit the coinbase sigchecks reservation, so
+        # mine with the default block size. The mempool is persisted.
+        self.restart_node(0, extra_args=[])
+        assert_equal(sum(bucket['count']
+                     for bucket in node.getfeehistogram()), NUM_TXS)
+        self.generate(node, 1)
+        assert_equal(node.getfeehistogram(), [])
+        assert_equal(node.estimatefee(1), min_fee)
+
+
+if __name__ == '__main__':
+    MempoolFeeHistogramTest().main()
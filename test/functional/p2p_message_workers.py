@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 The Bitcoin developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""Test the message worker threads serving read-only requests.
+
+With -msgworkers, getdata, getheaders and ping are served by the worker
+threads. Check that they are served, that the responses to a peer stay in the
+order of its requests, and that the other messages are still processed.
+"""
+
+from test_framework.blocktools import create_block, create_coinbase
+from test_framework.messages import (
+    MSG_BLOCK,
+    CInv,
+    msg_block,
+    msg_getdata,
+    msg_getheaders,
+    msg_tx,
+)
+from test_framework.p2p import P2PInterface
+from test_framework.test_framework import BitcoinTestFramework
+from test_framework.util import assert_equal
+from test_framework.wallet import MiniWallet
+
+
+class P2PRecordOrder(P2PInterface):
+    def __init__(self):
+        super().__init__()
+        self.received = []
+
+    def on_block(self, message):
+        message.block.calc_sha256()
+        self.received.append(('block', message.block.sha256))
+
+    def on_pong(self, message):
+        super().on_pong(message)
+        self.received.append(('pong', message.nonce))
+
+
+class MessageWorkersTest(BitcoinTestFramework):
+    def set_test_params(self):
+        self.num_nodes = 1
+        self.extra_args = [['-msgworkers=2']]
+
+    def run_test(self):
+        node = self.nodes[0]
+        wallet = MiniWallet(node)
+        wallet.rescan_utxos()
+
+        self.log.info("Check that historical blocks are served in order")
+        peer = node.add_p2p_connection(P2PRecordOrder())
+        block_hashes = [int(node.getblockhash(height), 16)
+                        for height in range(1, 101)]
+        peer.send_message(msg_getdata([CInv(MSG_BLOCK, h)
+                                       for h in block_hashes]))
+        peer.sync_with_ping()
+        # The pong is only sent once all the requested blocks are.
+        assert_equal([hash for (kind, hash) in peer.received[:-1]],
+                     block_hashes)
+        assert_equal(peer.received[-1][0], 'pong')
+
+        self.log.info("Check that getheaders is served")
+        getheaders = msg_getheaders()
+        getheaders.locator.vHave = [int(node.getblockhash(0), 16)]
+        peer.send_and_ping(getheaders)
+        headers = peer.last_message['headers'].headers
+        assert_equal(len(headers), node.getblockcount())
+
+        self.log.info(
+            "Check that other messages are processed while blocks are served")
+        requester = node.add_p2p_connection(P2PRecordOrder())
+        requester.send_message(msg_getdata([CInv(MSG_BLOCK, h)
+                                            for h in block_hashes]))
+
+        sender = node.add_p2p_connection(P2PInterface())
+        tx = wallet.create_self_transfer(from_node=node)
+        sender.send_and_ping(msg_tx(tx['tx']))
+        assert tx['txid'] in node.getrawmempool()
+
+        tip = node.getblockheader(node.getbestblockhash())
+        block = create_block(int(tip['hash'], 16),
+                             create_coinbase(tip['height'] + 1),
+                             tip['time'] + 1)
+        block.solve()
+        sender.send_and_ping(msg_block(block))
+        assert_equal(node.getbestblockhash(), block.hash)
+
+        requester.sync_with_ping()
+        assert_equal([hash for (kind, hash) in requester.received[:-1]],
+                     block_hashes)
+
+
+if __name__ == '__main__':
+    MessageWorkersTest().main()
@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022 The Bitcoin developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""Test package relay: sendpackages, getpkgtxns and pkgtxns messages.
+
+Once a parent is rejected for being below the minimum relay fee, its orphan
+child is requested and accepted as a package, and the node serves the
+packages of its own mempool transactions.
+"""
+
+import time
+from decimal import Decimal
+
+from test_framework.messages import (
+    msg_getpkgtxns,
+    msg_pkgtxns,
+    msg_sendpackages,
+    msg_tx,
+)
+from test_framework.p2p import P2PInterface, p2p_lock
+from test_framework.test_framework import BitcoinTestFramework
+from test_framework.util import assert_equal
+from test_framework.wallet import MiniWallet
+
+
+class PackageRelayPeer(P2PInterface):
+    def __init__(self):
+        super().__init__()
+        self.pkg_requests = []
+
+    def on_getpkgtxns(self, message):
+        self.pkg_requests.append(message.txid)
+
+    def wait_for_pkg_request(self, txid):
+        self.wait_until(lambda: txid in self.pkg_requests)
+
+
+class PackageRelayTest(BitcoinTestFramework):
+    def set_test_params(self):
+        self.num_nodes = 1
+        self.setup_clean_chain = True
+
+    def create_cpfp_package(self, wallet):
+        node = self.nodes[0]
+        utxo = wallet.get_utxo()
+        # The parent pays no fee and is rejected on its own.
+        parent = wallet.create_self_transfer(
+            from_node=node, utxo_to_spend=utxo, fee_rate=0,
+            mempool_valid=False)
+        # The child spends the parent and pays for both transactions.
+        child = wallet.create_self_transfer(
+            from_node=node,
+            utxo_to_spend={
+                'txid': parent['txid'],
+                'vout': 0,
+                'value': utxo['value']},
+            fee_rate=Decimal("10000.00"), mempool_valid=False)
+        return parent, child
+
+    def run_test(self):
+        node = self.nodes[0]
+        wallet = MiniWallet(node)
+        # One coin for each package created below
+        self.generate(wallet, 4)
+        self.generate(node, 100)
+
+        self.log.info("Check that the node signals package relay support")
+        peer = node.add_p2p_connection(PackageRelayPeer())
+        peer.wait_until(lambda: 'sendpackages' in peer.last_message)
+
+        self.log.info(
+            "Check that orphans from peers without package relay don't "
+            "trigger a package request")
+        parent, child = self.create_cpfp_package(wallet)
+        peer.send_and_ping(msg_tx(child['tx']))
+        peer.send_and_ping(msg_tx(parent['tx']))
+        with p2p_lock:
+            assert_equal(peer.pkg_requests, [])
+        assert parent['txid'] not in node.getrawmempool()
+        assert child['txid'] not in node.getrawmempool()
+
+        peer.send_message(msg_sendpackages())
+
+        self.log.info(
+            "Check that an orphan is requested as a package once its parent "
+            "is rejected for its low fee")
+        parent, child = self.create_cpfp_package(wallet)
+        peer.send_and_ping(msg_tx(child['tx']))
+        with p2p_lock:
+            assert_equal(peer.pkg_requests, [])
+        peer.send_message(msg_tx(parent['tx']))
+        peer.wait_for_pkg_request(int(child['txid'], 16))
+        peer.send_and_ping(msg_pkgtxns([parent['tx'], child['tx']]))
+        assert parent['txid'] in node.getrawmempool()
+        assert child['txid'] in node.getrawmempool()
+
+        self.log.info(
+            "Check that a child of a low fee parent is requested as a "
+            "package")
+        parent, child = self.create_cpfp_package(wallet)
+        peer.send_and_ping(msg_tx(parent['tx']))
+        assert parent['txid'] not in node.getrawmempool()
+        peer.send_message(msg_tx(child['tx']))
+        peer.wait_for_pkg_request(int(child['txid'], 16))
+        peer.send_and_ping(msg_pkgtxns([parent['tx'], child['tx']]))
+        assert parent['txid'] in node.getrawmempool()
+        assert child['txid'] in node.getrawmempool()
+
+        self.log.info("Check that unsolicited packages are ignored")
+        parent2, child2 = self.create_cpfp_package(wallet)
+        peer.send_and_ping(msg_pkgtxns([parent2['tx'], child2['tx']]))
+        assert parent2['txid'] not in node.getrawmempool()
+        assert child2['txid'] not in node.getrawmempool()
+
+        self.log.info("Check that the node serves packages from its mempool")
+        # Make sure the transactions are old enough to be served
+        # unconditionally.
+        node.setmocktime(int(time.time()) + 600)
+        requester = node.add_p2p_connection(PackageRelayPeer())
+        requester.send_and_ping(msg_getpkgtxns(int(child['txid'], 16)))
+        with p2p_lock:
+            pkgtxns = requester.last_message['pkgtxns']
+        for tx in pkgtxns.txs:
+            tx.rehash()
+        assert_equal([tx.hash for tx in pkgtxns.txs],
+                     [parent['txid'], child['txid']])
+
+        self.log.info("Check that unknown packages are answered with notfound")
+        requester.send_and_ping(msg_getpkgtxns(int(child2['txid'], 16)))
+        with p2p_lock:
+            notfound = requester.last_message['notfound']
+        assert_equal(notfound.vec[0].hash, int(child2['txid'], 16))
+
+
+if __name__ == '__main__':
+    PackageRelayTest().main()
@@ -2198,6 +2198,57 @@ class msg_avaproofsreq:
             len(self.indices), self.indices)
 
 
+class msg_sendpackages:
+    __slots__ = ()
+    msgtype = b"sendpackages"
+
+    def __init__(self):
+        pass
+
+    def deserialize(self, f):
+        pass
+
+    def serialize(self):
+        return b""
+
+    def __repr__(self):
+        return "msg_sendpackages()"
+
+
+class msg_getpkgtxns:
+    __slots__ = ("txid",)
+    msgtype = b"getpkgtxns"
+
+    def __init__(self, txid=0):
+        self.txid = txid
+
+    def deserialize(self, f):
+        self.txid = deser_uint256(f)
+
+    def serialize(self):
+        return ser_uint256(self.txid)
+
+    def __repr__(self):
+        return "msg_getpkgtxns(txid={:064x})".format(self.txid)
+
+
+class msg_pkgtxns:
+    __slots__ = ("txs",)
+    msgtype = b"pkgtxns"
+
+    def __init__(self, txs=None):
+        self.txs = txs if txs is not None else []
+
+    def deserialize(self, f):
+        self.txs = deser_vector(f, CTransaction)
+
+    def serialize(self):
+        return ser_vector(self.txs)
+
+    def __repr__(self):
+        return "msg_pkgtxns(txs={})".format(repr(self.txs))
+
+
 class TestFrameworkMessages(unittest.TestCase):
     def test_avalanche_proof_serialization_round_trip(self):
         """Verify that an AvalancheProof object is unchanged after a round-trip